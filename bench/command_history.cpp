@@ -0,0 +1,80 @@
+// Per-command cost of heap-allocated commands (executeCommand) against
+// commands held inline in the history (execute<T>), for a scripted run of
+// done/undone toggles followed by undoing all of them.
+//
+//   bench/command_history [commands]    (default 200000)
+#include "../include/TaskManager.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr size_t kTasks = 1000;
+
+struct Run {
+  double executeNs;
+  double undoNs;
+};
+
+template <typename Execute>
+Run timeRun(TaskManager &manager, const std::vector<std::string> &numbers,
+            Execute execute) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < numbers.size(); ++i) {
+    execute(i % 2 == 0, numbers[i]);
+  }
+  auto mid = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < numbers.size(); ++i) {
+    manager.undo();
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::nano> executed = mid - start;
+  std::chrono::duration<double, std::nano> undone = end - mid;
+  return {executed.count() / numbers.size(), undone.count() / numbers.size()};
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+  const std::string path = "/tmp/todo_bench_command_history.json";
+  std::remove(path.c_str());
+  TaskManager manager(path);
+  manager.setOption("undo-depth " + std::to_string(count));
+  for (size_t i = 0; i < kTasks; ++i) {
+    manager.add("work:low:task number " + std::to_string(i));
+  }
+  std::vector<std::string> numbers;
+  numbers.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    numbers.push_back(std::to_string(1 + (i * 7919) % kTasks));
+  }
+
+  std::printf("%zu commands on %zu tasks\n", count, kTasks);
+  std::printf("path                 execute ns   undo ns\n");
+  for (int round = 0; round < 2; ++round) {
+    Run heap = timeRun(manager, numbers, [&](bool done, const std::string &n) {
+      if (done) {
+        manager.executeCommand(std::make_unique<DoneCommand>(manager, n));
+      } else {
+        manager.executeCommand(std::make_unique<UndoneCommand>(manager, n));
+      }
+    });
+    Run inline_ = timeRun(manager, numbers,
+                          [&](bool done, const std::string &n) {
+                            if (done) {
+                              manager.execute<DoneCommand>(n);
+                            } else {
+                              manager.execute<UndoneCommand>(n);
+                            }
+                          });
+    std::printf("make_unique + virtual %10.1f %9.1f\n", heap.executeNs,
+                heap.undoNs);
+    std::printf("inline AnyCommand     %10.1f %9.1f\n", inline_.executeNs,
+                inline_.undoNs);
+  }
+  std::remove(path.c_str());
+  return 0;
+}
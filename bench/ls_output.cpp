@@ -0,0 +1,59 @@
+// Throughput of rendering ls with and without color escapes.
+//
+//   bench/ls_output [tasks]    (default 1000000)
+#include "../include/TaskManager.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+namespace {
+// Discards output but counts it, like a fast pipe reader.
+struct CountingSink : std::streambuf {
+  size_t bytes = 0;
+  std::streamsize xsputn(const char *, std::streamsize n) override {
+    bytes += static_cast<size_t>(n);
+    return n;
+  }
+  int_type overflow(int_type c) override {
+    ++bytes;
+    return c;
+  }
+};
+
+void run(TaskManager &manager, const char *label, const std::string &flag) {
+  CountingSink sink;
+  std::streambuf *old = std::cout.rdbuf(&sink);
+  double best = 1e30;
+  for (int i = 0; i < 3; ++i) {
+    sink.bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    manager.ls(flag);
+    std::chrono::duration<double, std::milli> took =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, took.count());
+  }
+  std::cout.rdbuf(old);
+  std::printf("%-6s %8.1f ms  %6.1f MB  %7.1f MB/s\n", label, best,
+              sink.bytes / 1e6, sink.bytes / 1e3 / best);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  const std::string path = "/tmp/todo_bench_ls_output.json";
+  std::remove(path.c_str());
+  TaskManager manager(path);
+  const char *priorities[] = {"low", "medium", "high"};
+  for (size_t i = 0; i < count; ++i) {
+    manager.add(std::string(i % 2 ? "work" : "home") + ":" + priorities[i % 3] +
+                ":Task number " + std::to_string(i));
+  }
+
+  manager.setOption("color on");
+  run(manager, "color", "");
+  run(manager, "plain", "--plain");
+  return 0;
+}
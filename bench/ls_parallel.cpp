@@ -0,0 +1,55 @@
+// ls search latency by filter thread count.
+//
+//   bench/ls_parallel [tasks]    (default 1000000)
+#include "../include/TaskManager.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+double timeLs(TaskManager &manager, const std::string &flag) {
+  std::ostringstream sink;
+  std::streambuf *old = std::cout.rdbuf(sink.rdbuf());
+  double best = 1e30;
+  for (int i = 0; i < 3; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    manager.ls(flag);
+    std::chrono::duration<double, std::milli> took =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, took.count());
+  }
+  std::cout.rdbuf(old);
+  return best;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  const std::string path = "/tmp/todo_bench_ls_parallel.json";
+  std::remove(path.c_str());
+  TaskManager manager(path);
+  manager.setOption("query-cache 0");
+  manager.setOption("parallel-threshold 0");
+  const char *words[] = {"meeting", "invoice", "groceries", "review",
+                         "dentist", "report",  "laundry",   "deploy"};
+  for (size_t i = 0; i < count; ++i) {
+    manager.add(std::string(i % 2 ? "work" : "home") + ":low:" +
+                words[i % 8] + " " + words[(i / 8) % 8] + " number " +
+                std::to_string(i));
+  }
+
+  std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+  std::printf("threads     find    regex    fuzzy  (ms)\n");
+  for (size_t threads : {1, 2, 4, 8, 16}) {
+    manager.setOption("threads " + std::to_string(threads));
+    std::printf("%7zu %8.1f %8.1f %8.1f\n", threads,
+                timeLs(manager, "--find invoice --count"),
+                timeLs(manager, "--regex ^invoice (review|report) --count"),
+                timeLs(manager, "--fuzzy invoise --count"));
+  }
+  return 0;
+}
@@ -0,0 +1,54 @@
+// Latency of ls text searches over a large list.
+//
+//   bench/ls_search [tasks]    (default 1000000)
+#include "../include/TaskManager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+void run(TaskManager &manager, const char *label, const std::string &flag) {
+  std::ostringstream sink;
+  std::streambuf *old = std::cout.rdbuf(sink.rdbuf());
+  double best = 1e30;
+  for (int i = 0; i < 3; ++i) {
+    sink.str("");
+    auto start = std::chrono::steady_clock::now();
+    manager.ls(flag);
+    std::chrono::duration<double, std::milli> took =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, took.count());
+  }
+  std::cout.rdbuf(old);
+  const std::string out = sink.str();
+  std::printf("%-8s %8.1f ms  %6zu lines  ls %s\n", label, best,
+              static_cast<size_t>(std::count(out.begin(), out.end(), '\n')),
+              flag.c_str());
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  const std::string path = "/tmp/todo_bench_ls_search.json";
+  std::remove(path.c_str());
+  TaskManager manager(path);
+  // Repeated queries would be answered by the result cache.
+  manager.setOption("query-cache 0");
+  const char *words[] = {"meeting", "invoice", "groceries", "review",
+                         "dentist", "report",  "laundry",   "deploy"};
+  for (size_t i = 0; i < count; ++i) {
+    manager.add(std::string(i % 2 ? "work" : "home") + ":low:" +
+                words[i % 8] + " " + words[(i / 8) % 8] + " number " +
+                std::to_string(i));
+  }
+
+  run(manager, "find", "--find invoice --plain");
+  run(manager, "fuzzy", "--fuzzy invoise --plain");
+  run(manager, "regex", "--regex ^invoice (review|report) --plain");
+  run(manager, "fuzzy-10", "--fuzzy invoise --limit 10 --plain");
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Compares the packed Task against the previous layout (id, two
+// std::strings, Priority enum, bool): memory per task and the time to scan
+// done/priority over all tasks.
+//
+//   bench/task_layout [tasks]    (default 10000000)
+#include "../include/Task.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+size_t allocatedBytes = 0;
+
+struct LegacyTask {
+  enum class LegacyPriority { low, medium, high };
+  uint64_t id;
+  std::string text;
+  std::string category;
+  LegacyPriority priority;
+  bool done;
+};
+
+// Lengths picked to look like a real list: mostly short phrases, some
+// sentences.
+std::string makeText(size_t i) {
+  static const size_t lengths[] = {9, 12, 14, 17, 19, 22, 26, 31, 38, 54};
+  return std::string(lengths[i % std::size(lengths)], 'a' + i % 26);
+}
+
+template <typename F> double bestOfFive(F scan) {
+  double best = 1e30;
+  for (int run = 0; run < 5; ++run) {
+    auto start = std::chrono::steady_clock::now();
+    scan();
+    std::chrono::duration<double, std::milli> took =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, took.count());
+  }
+  return best;
+}
+} // namespace
+
+void *operator new(size_t size) {
+  allocatedBytes += size;
+  if (void *p = std::malloc(size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+int main(int argc, char **argv) {
+  const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  static const char *categories[] = {"work", "home", "errands", "general"};
+  size_t volatile sink = 0;
+
+  {
+    size_t before = allocatedBytes;
+    std::vector<LegacyTask> tasks;
+    tasks.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      tasks.push_back({i + 1, makeText(i), categories[i % 4],
+                       static_cast<LegacyTask::LegacyPriority>(i % 3),
+                       i % 2 == 0});
+    }
+    const size_t bytes = allocatedBytes - before;
+    double ms = bestOfFive([&] {
+      size_t hits = 0;
+      for (const auto &task : tasks) {
+        hits += !task.done &&
+                task.priority == LegacyTask::LegacyPriority::high;
+      }
+      sink = hits;
+    });
+    std::printf("legacy  sizeof=%zu  bytes/task=%.1f  scan=%.2f ms\n",
+                sizeof(LegacyTask), double(bytes) / count, ms);
+  }
+  {
+    size_t before = allocatedBytes;
+    std::vector<Task> tasks;
+    tasks.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      tasks.emplace_back(i + 1, makeText(i), categories[i % 4],
+                         static_cast<Priority>(i % 3), i % 2 == 0);
+    }
+    const size_t bytes = allocatedBytes - before;
+    double ms = bestOfFive([&] {
+      size_t hits = 0;
+      for (const auto &task : tasks) {
+        hits += !task.isDone() && task.getPriority() == Priority::high;
+      }
+      sink = hits;
+    });
+    std::printf("packed  sizeof=%zu  bytes/task=%.1f  scan=%.2f ms\n",
+                sizeof(Task), double(bytes) / count, ms);
+  }
+  return 0;
+}
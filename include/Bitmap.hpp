@@ -0,0 +1,42 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Growable bitset addressed by task row. Bits past size() are always zero so
+// whole-word operations and popcounts need no masking.
+class Bitmap {
+private:
+  std::vector<uint64_t> words_;
+  size_t size_ = 0;
+
+public:
+  Bitmap() = default;
+  Bitmap(size_t size, bool value);
+
+  size_t size() const { return size_; }
+  bool test(size_t pos) const { return (words_[pos / 64] >> (pos % 64)) & 1; }
+  void set(size_t pos, bool value);
+  void push(bool value);
+  void insert(size_t pos, bool value);
+  void erase(size_t pos);
+  void clear();
+
+  size_t count() const;
+  Bitmap &operator&=(const Bitmap &other);
+  Bitmap &operator|=(const Bitmap &other);
+  void appendSetBits(std::vector<size_t> &out) const;
+  // Calls visit(pos) for each set bit in order until it returns false.
+  template <typename Visit> void forEachSetBit(Visit visit) const {
+    for (size_t i = 0; i < words_.size(); ++i) {
+      uint64_t word = words_[i];
+      while (word != 0) {
+        if (!visit(i * 64 + std::countr_zero(word))) {
+          return;
+        }
+        word &= word - 1;
+      }
+    }
+  }
+};
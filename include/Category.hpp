@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using CategoryId = uint16_t;
+
+// Interned category names. Tasks only carry a CategoryId; the name is looked
+// up here. The table is shared by every Task so tasks can be copied between
+// managers and commands without re-interning.
+class CategoryTable {
+private:
+  // deque keeps names at stable addresses, so the map can key on views.
+  std::deque<std::string> names_;
+  std::unordered_map<std::string_view, CategoryId> ids_;
+
+public:
+  static CategoryTable &shared();
+
+  CategoryId intern(std::string_view name);
+  std::optional<CategoryId> find(std::string_view name) const;
+  const std::string &name(CategoryId id) const { return names_[id]; }
+  size_t size() const { return names_.size(); }
+  // Every id, ordered by case-folded name.
+  std::vector<CategoryId> idsByName() const;
+};
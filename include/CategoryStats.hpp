@@ -0,0 +1,28 @@
+#pragma once
+#include "Category.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Task counts per category and flags byte (Task::pack of priority and
+// done), in a flat array indexed by CategoryId. TaskManager keeps it in step
+// with tasks_, so per-category summaries cost O(categories), not O(tasks).
+class CategoryStats {
+public:
+  using Counts = std::array<uint32_t, 8>;
+
+private:
+  std::vector<Counts> counts_;
+
+public:
+  void add(CategoryId category, uint8_t flags);
+  void remove(CategoryId category, uint8_t flags);
+  void clear() { counts_.clear(); }
+
+  // One past the highest category id that has had a task.
+  size_t size() const { return counts_.size(); }
+  // All zero for categories that never had a task.
+  const Counts &counts(CategoryId category) const;
+  uint32_t total(CategoryId category) const;
+};
@@ -1,13 +1,14 @@
 #pragma once
-#include <ostream>
 #include <string>
 
-class Color {
+// Wraps whatever is written to out during its lifetime in an ANSI color.
+// Works with std::ostream and OutputBuffer alike.
+template <typename Out> class Color {
 private:
-  std::ostream &os_;
+  Out &os_;
 
 public:
-  Color(std::ostream &os, const std::string &color) : os_(os) {
+  Color(Out &os, const std::string &color) : os_(os) {
     os_ << "\033[" << color << "m";
   };
   ~Color() { os_ << "\033[0m"; }
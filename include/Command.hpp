@@ -1,65 +1,91 @@
 #pragma once
 #include "Task.hpp"
+#include "TaskText.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
+#include <variant>
 #include <vector>
 
 enum class CustomError;
 class TaskManager;
-enum class Priority;
+enum class Priority : uint8_t;
 
+// After execute a command keeps only what it needs to undo and redo itself:
+// task ids and the changed fields, not the typed input.
 class Command {
 public:
   virtual ~Command() = default;
   virtual CustomError execute() = 0;
   virtual CustomError undo() = 0;
+  // Repeats execute after an undo, acting on the same task.
+  virtual CustomError redo() = 0;
+  // Approximate bytes held by the command, heap included. Only meaningful
+  // after execute.
+  virtual size_t footprint() const = 0;
 };
-class AddCommand : public Command {
+class AddCommand final : public Command {
 private:
   TaskManager &manager_;
-  uint64_t id_;
   std::string text_;
+  uint64_t id_;
+  // The task while it is undone, with its row.
+  std::optional<Task> task_;
+  size_t index_;
 
 public:
   AddCommand(TaskManager &manager, const std::string &text);
   CustomError execute() override;
   CustomError undo() override;
+  CustomError redo() override;
+  size_t footprint() const override;
 };
-class EditCommand : public Command {
+class EditCommand final : public Command {
 private:
   TaskManager &manager_;
-  size_t idx_;
   std::string text_;
-  std::string previousText_;
+  uint64_t id_;
+  // The text the task does not have right now; undo and redo swap it in.
+  TaskText otherText_;
 
 public:
   EditCommand(TaskManager &manager, const std::string &text);
   CustomError execute() override;
   CustomError undo() override;
+  CustomError redo() override;
+  size_t footprint() const override;
 };
-class DoneCommand : public Command {
+class DoneCommand final : public Command {
 private:
   TaskManager &manager_;
-  const std::string text_;
+  std::string text_;
+  uint64_t id_;
   bool previousDone_;
 
 public:
   DoneCommand(TaskManager &manager, const std::string &text);
   CustomError execute() override;
   CustomError undo() override;
+  CustomError redo() override;
+  size_t footprint() const override;
 };
-class UndoneCommand : public Command {
+class UndoneCommand final : public Command {
 private:
   TaskManager &manager_;
-  const std::string text_;
+  std::string text_;
+  uint64_t id_;
   bool previousDone_;
 
 public:
   UndoneCommand(TaskManager &manager, const std::string &text);
   CustomError execute() override;
   CustomError undo() override;
+  CustomError redo() override;
+  size_t footprint() const override;
 };
-class DelCommand : public Command {
+class DelCommand final : public Command {
 private:
   TaskManager &manager_;
   std::string text_;
@@ -70,14 +96,41 @@ public:
   DelCommand(TaskManager &manager, const std::string &text);
   CustomError execute() override;
   CustomError undo() override;
+  CustomError redo() override;
+  size_t footprint() const override;
 };
-class ClearCommand : public Command {
+class ClearCommand final : public Command {
 private:
   TaskManager &manager_;
+  // Filled while the clear is in effect, empty after undo.
   std::vector<Task> previousTasks_;
 
 public:
   ClearCommand(TaskManager &manager);
   CustomError execute() override;
   CustomError undo() override;
+  CustomError redo() override;
+  size_t footprint() const override;
 };
+
+// A command held by value, so histories keep commands inline instead of one
+// heap block each. Other Command subclasses go in the unique_ptr.
+using AnyCommand =
+    std::variant<AddCommand, EditCommand, DoneCommand, UndoneCommand,
+                 DelCommand, ClearCommand, std::unique_ptr<Command>>;
+
+// Calls f with the Command held. The concrete classes are final, so those
+// calls bind statically; only the unique_ptr alternative is dispatched
+// virtually.
+template <typename Any, typename F>
+decltype(auto) visitCommand(Any &command, F &&f) {
+  return std::visit(
+      [&](auto &held) -> decltype(auto) {
+        if constexpr (requires { *held; }) {
+          return f(*held);
+        } else {
+          return f(held);
+        }
+      },
+      command);
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Approximate substring matcher for ls --fuzzy (Myers' bit-parallel edit
+// distance). The pattern is compiled once into one bit mask per byte value;
+// each text byte then costs a handful of word operations.
+class FuzzyPattern {
+private:
+  std::array<uint64_t, 256> masks_{};
+  unsigned length_;
+  unsigned maxErrors_;
+
+public:
+  // One machine word holds the whole pattern.
+  static constexpr size_t kMaxLength = 64;
+
+  // pattern must be 1..kMaxLength bytes. Allowed errors grow with its
+  // length: none up to 3 bytes, then one per 4 bytes, at most 3.
+  explicit FuzzyPattern(std::string_view pattern);
+
+  unsigned maxErrors() const { return maxErrors_; }
+  // Fewest edits turning the pattern into some substring of text, or
+  // maxErrors() + 1 if that is more than maxErrors().
+  unsigned distance(std::string_view text) const;
+};
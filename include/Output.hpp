@@ -0,0 +1,59 @@
+#pragma once
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// When ls decorates priorities with ANSI colors. automatic colors only when
+// stdout is a terminal.
+enum class ColorMode { automatic, always, never };
+bool stdoutIsTerminal();
+
+// Collects formatted output in a caller-owned buffer and hands it to the
+// stream in large writes instead of one write per line. Whatever is left is
+// written out on destruction.
+class OutputBuffer {
+private:
+  std::ostream &os_;
+  std::string &buffer_;
+  size_t threshold_;
+
+public:
+  static constexpr size_t kDefaultThreshold = 64 * 1024;
+
+  OutputBuffer(std::ostream &os, std::string &storage,
+               size_t threshold = kDefaultThreshold);
+  ~OutputBuffer() { flush(); }
+  OutputBuffer(const OutputBuffer &) = delete;
+  OutputBuffer &operator=(const OutputBuffer &) = delete;
+
+  OutputBuffer &operator<<(std::string_view text) {
+    buffer_.append(text);
+    return maybeFlush();
+  }
+  OutputBuffer &operator<<(char c) {
+    buffer_.push_back(c);
+    return maybeFlush();
+  }
+  template <std::integral T> OutputBuffer &operator<<(T value) {
+    char digits[24];
+    auto [end, err] = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer_.append(digits, end);
+    return maybeFlush();
+  }
+  void flush();
+
+private:
+  OutputBuffer &maybeFlush() {
+    if (buffer_.size() >= threshold_) {
+      flush();
+    }
+    return *this;
+  }
+};
+
+// Writes text as a quoted JSON string, escaping quotes, backslashes and
+// control characters. Other bytes, including UTF-8, pass through.
+void writeJsonString(OutputBuffer &out, std::string_view text);
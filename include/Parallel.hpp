@@ -0,0 +1,69 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Chunked parallel loops over ls candidate rows. Chunks are contiguous and
+// merged in chunk order, so results come out in the same order as a serial
+// pass.
+
+// Calls work(begin, end, chunk) for `chunks` contiguous slices of
+// [0, size), each on its own thread, and returns when all have finished.
+// Chunks whose thread cannot be started run on the calling thread.
+template <typename Work>
+void forEachChunk(size_t size, size_t chunks, Work work) {
+  if (chunks <= 1) {
+    work(size_t{0}, size, size_t{0});
+    return;
+  }
+  auto run = [&work, size, chunks](size_t chunk) {
+    work(size * chunk / chunks, size * (chunk + 1) / chunks, chunk);
+  };
+  std::vector<std::jthread> workers;
+  workers.reserve(chunks - 1);
+  size_t started = 1;
+  try {
+    for (; started < chunks; ++started) {
+      workers.emplace_back(run, started);
+    }
+  } catch (const std::system_error &) {
+    // Out of threads; the rest run serially below.
+  }
+  // The calling thread takes the first chunk instead of idling.
+  run(0);
+  for (size_t chunk = started; chunk < chunks; ++chunk) {
+    run(chunk);
+  }
+}
+
+// Keeps the rows for which keep(row, scratch) is true, in order. Each chunk
+// compacts its own slice in place; the slices are then moved together.
+// scratch is a per-thread string for keep to use.
+template <typename Keep>
+void filterRows(std::vector<size_t> &rows, size_t threads, Keep keep) {
+  std::vector<size_t> kept(std::max<size_t>(threads, 1));
+  forEachChunk(rows.size(), kept.size(),
+               [&](size_t begin, size_t end, size_t chunk) {
+                 std::string scratch;
+                 size_t out = begin;
+                 for (size_t i = begin; i < end; ++i) {
+                   if (keep(rows[i], scratch)) {
+                     rows[out++] = rows[i];
+                   }
+                 }
+                 kept[chunk] = out - begin;
+               });
+  size_t size = 0;
+  for (size_t chunk = 0; chunk < kept.size(); ++chunk) {
+    const size_t begin = rows.size() * chunk / kept.size();
+    if (begin != size) {
+      std::copy(rows.begin() + begin, rows.begin() + begin + kept[chunk],
+                rows.begin() + size);
+    }
+    size += kept[chunk];
+  }
+  rows.resize(size);
+}
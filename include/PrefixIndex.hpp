@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Lowercased words of every task, each paired with its task id and kept in
+// sorted order. All words starting with a prefix form one contiguous range,
+// so a lookup is a tree search plus a walk over the matches.
+class PrefixIndex {
+public:
+  using Entry = std::pair<std::string, uint64_t>;
+  using Iterator = std::set<Entry>::const_iterator;
+  // The entries whose word starts with prefix, as [begin, end).
+  struct Range {
+    Iterator begin;
+    Iterator end;
+    bool empty() const { return begin == end; }
+  };
+
+private:
+  std::set<Entry> entries_;
+
+  Iterator endOf(std::string_view prefix) const;
+
+public:
+  // folded is the task's lowercased text.
+  void add(uint64_t id, std::string_view folded);
+  void remove(uint64_t id, std::string_view folded);
+  void clear() { entries_.clear(); }
+  size_t size() const { return entries_.size(); }
+
+  Range find(std::string_view prefix) const;
+};
+
+// Words of already lowercased text: runs of ASCII letters and digits, and
+// of non-ASCII bytes so UTF-8 characters stay inside their word.
+std::vector<std::string_view> indexWords(std::string_view folded);
@@ -0,0 +1,44 @@
+#pragma once
+#include "RegexFilter.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+enum class SortKey { none, id, done, priority, text, category };
+enum class OutputFormat { human, jsonl };
+enum class GroupKey { none, category };
+
+// Parsed form of the options given to ls.
+struct LsQuery {
+  std::optional<bool> done;
+  // Bit i set means Priority(i) is wanted; zero means any priority.
+  uint8_t priorities = 0;
+  std::optional<std::string> category;
+  SortKey sort = SortKey::none;
+  // Already lowercased.
+  std::string find;
+  // Lowercased --fuzzy text, at most FuzzyPattern::kMaxLength bytes.
+  std::string fuzzy;
+  // Compiled once by the parser and shared by copies of the query.
+  std::shared_ptr<const RegexFilter> regex;
+  bool count = false;
+  bool plain = false;
+  bool pager = false;
+  bool explain = false;
+  OutputFormat format = OutputFormat::human;
+  GroupKey group = GroupKey::none;
+  std::optional<size_t> limit;
+  size_t offset = 0;
+};
+
+std::optional<LsQuery> parseLsQuery(const std::string &flag);
+
+// Whether a task with this flags byte passes the done and priority filters.
+bool flagsMatch(const LsQuery &query, uint8_t flags);
+
+// Canonical text of the options that decide which rows ls returns and in
+// what order. Output-only options (format, color, pager, group, explain)
+// are left out, so they share a cache entry.
+std::string normalizedKey(const LsQuery &query);
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Small LRU cache of ls results (row index lists). Each entry records the
+// TaskManager version it was computed at and is only returned for that
+// version, so any mutation invalidates everything without a sweep.
+class QueryCache {
+private:
+  struct Entry {
+    std::string key;
+    uint64_t version;
+    std::vector<size_t> rows;
+  };
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  size_t capacity_;
+  size_t hits_ = 0;
+
+public:
+  explicit QueryCache(size_t capacity) : capacity_(capacity) {}
+
+  const std::vector<size_t> *find(const std::string &key, uint64_t version);
+  void insert(const std::string &key, uint64_t version,
+              const std::vector<size_t> &rows);
+  void setCapacity(size_t capacity);
+  size_t size() const { return entries_.size(); }
+  size_t hits() const { return hits_; }
+};
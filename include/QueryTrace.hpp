@@ -0,0 +1,36 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Stages of one ls run for ls --explain: what each stage did, how many rows
+// came out of it and the wall time since the previous stage ended.
+class QueryTrace {
+public:
+  using Clock = std::chrono::steady_clock;
+
+private:
+  struct Stage {
+    std::string name;
+    std::string detail;
+    std::optional<size_t> rows;
+    double ms;
+  };
+  std::vector<Stage> stages_;
+  Clock::time_point started_;
+  Clock::time_point last_;
+
+public:
+  explicit QueryTrace(Clock::time_point started = Clock::now())
+      : started_(started), last_(started) {}
+
+  void stage(std::string name, std::string detail,
+             std::optional<size_t> rows = std::nullopt);
+  size_t size() const { return stages_.size(); }
+  const std::string &name(size_t i) const { return stages_[i].name; }
+  const std::string &detail(size_t i) const { return stages_[i].detail; }
+  void print(std::ostream &out) const;
+};
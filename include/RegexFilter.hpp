@@ -0,0 +1,32 @@
+#pragma once
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compiled ls --regex pattern (ECMAScript, case-insensitive). Literal runs
+// that every match must contain are pulled out of the pattern so most
+// tasks are rejected by a plain substring scan before the regex runs.
+class RegexFilter {
+private:
+  std::string pattern_;
+  std::regex regex_;
+  // Lowercased, longest first.
+  std::vector<std::string> literals_;
+
+  RegexFilter(std::string pattern, std::regex regex);
+
+public:
+  // nullopt if the pattern does not compile.
+  static std::optional<RegexFilter> compile(const std::string &pattern);
+
+  const std::string &pattern() const { return pattern_; }
+  const std::vector<std::string> &literals() const { return literals_; }
+  // folded is text lowercased; it is what the literals are checked against.
+  bool matches(std::string_view text, std::string_view folded) const;
+};
+
+// Literal substrings every match of an ECMAScript pattern contains. Only
+// top-level runs are used; alternation at top level yields none.
+std::vector<std::string> requiredLiterals(std::string_view pattern);
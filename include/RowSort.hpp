@@ -0,0 +1,67 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Stable linear-time sorts of row indices, used by ls for its sort keys.
+// Rows with equal keys keep their relative order.
+
+// key(row) must return a value below keyCount.
+template <typename KeyFn>
+void countingSortRows(std::vector<size_t> &rows, size_t keyCount, KeyFn key) {
+  std::vector<size_t> starts(keyCount + 1, 0);
+  for (size_t row : rows) {
+    ++starts[static_cast<size_t>(key(row)) + 1];
+  }
+  for (size_t k = 1; k <= keyCount; ++k) {
+    starts[k] += starts[k - 1];
+  }
+  std::vector<size_t> sorted(rows.size());
+  for (size_t row : rows) {
+    sorted[starts[static_cast<size_t>(key(row))]++] = row;
+  }
+  rows = std::move(sorted);
+}
+
+// LSD radix sort on a 64-bit key, one byte per pass. Passes where every key
+// has the same byte are skipped, so small ids take two or three passes.
+template <typename KeyFn>
+void radixSortRows(std::vector<size_t> &rows, KeyFn key) {
+  constexpr size_t kPasses = sizeof(uint64_t);
+  std::vector<std::pair<uint64_t, size_t>> items;
+  items.reserve(rows.size());
+  std::array<std::array<size_t, 256>, kPasses> counts{};
+  for (size_t row : rows) {
+    const uint64_t k = key(row);
+    items.emplace_back(k, row);
+    for (size_t pass = 0; pass < kPasses; ++pass) {
+      ++counts[pass][(k >> (8 * pass)) & 0xFF];
+    }
+  }
+
+  std::vector<std::pair<uint64_t, size_t>> buffer(items.size());
+  for (size_t pass = 0; pass < kPasses; ++pass) {
+    auto &count = counts[pass];
+    const uint64_t firstByte =
+        items.empty() ? 0 : (items.front().first >> (8 * pass)) & 0xFF;
+    if (count[firstByte] == items.size()) {
+      continue;
+    }
+    size_t start = 0;
+    for (auto &bucket : count) {
+      const size_t n = bucket;
+      bucket = start;
+      start += n;
+    }
+    for (const auto &item : items) {
+      buffer[count[(item.first >> (8 * pass)) & 0xFF]++] = item;
+    }
+    items.swap(buffer);
+  }
+
+  for (size_t i = 0; i < items.size(); ++i) {
+    rows[i] = items[i].second;
+  }
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "Category.hpp"
+#include "Fuzzy.hpp"
+#include "Query.hpp"
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+
+// A named ls query whose matching task ids are kept up to date by every
+// change to the task list, so opening it never scans all tasks.
+struct SavedView {
+  // ls options as the user typed them; this is what gets saved to disk.
+  std::string options;
+  LsQuery query;
+  // Interned when the view is saved so later tasks in a new category match.
+  std::optional<CategoryId> category;
+  std::optional<FuzzyPattern> fuzzy;
+  std::set<uint64_t> members;
+};
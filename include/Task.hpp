@@ -1,26 +1,57 @@
 #pragma once
+#include "Category.hpp"
+#include "TaskText.hpp"
 #include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
-enum class Priority { low = 0, medium = 1, high = 2 };
+enum class Priority : uint8_t { low = 0, medium = 1, high = 2 };
+std::string_view priorityName(Priority priority);
 class Task {
+public:
+  static constexpr uint8_t kPriorityMask = 0x03;
+  static constexpr uint8_t kDoneBit = 0x04;
+
 private:
   uint64_t id_;
-  std::string text_;
-  std::string category_;
-  Priority priority_;
-  bool done_;
+  // Allocated from whatever resource the owner passes in. Copies always go
+  // back to the default heap so they never outlive the owner's arena.
+  TaskText text_;
+  // Priority in the low two bits, done in kDoneBit.
+  uint8_t flags_;
+  CategoryId categoryId_;
 
 public:
-  Task(uint64_t id, const std::string &text,
+  static uint8_t pack(Priority priority, bool done) {
+    return static_cast<uint8_t>(static_cast<uint8_t>(priority) |
+                                (done ? kDoneBit : 0));
+  }
+
+  Task(uint64_t id, std::string_view text,
        const std::string &category = "general",
-       const Priority priority = Priority::low, bool done = false);
+       const Priority priority = Priority::low, bool done = false,
+       std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
   uint64_t getId() const { return id_; }
-  const std::string &getText() const { return text_; }
-  void changeText(const std::string &text) { text_ = text; }
-  std::string getCategory() const { return category_; }
-  Priority getPriority() const { return priority_; }
+  std::string_view getText() const { return text_.view(); }
+  void changeText(std::string_view text,
+                  std::pmr::memory_resource *resource =
+                      std::pmr::get_default_resource()) {
+    text_ = TaskText(text, resource);
+  }
+  const std::string &getCategory() const {
+    return CategoryTable::shared().name(categoryId_);
+  }
+  CategoryId getCategoryId() const { return categoryId_; }
+  Priority getPriority() const {
+    return static_cast<Priority>(flags_ & kPriorityMask);
+  }
+  uint8_t getFlags() const { return flags_; }
   std::string getPriorityString() const;
-  bool isDone() const { return done_; }
-  void markAsDone(bool done) { done_ = done; }
+  bool isDone() const { return flags_ & kDoneBit; }
+  void markAsDone(bool done) { flags_ = pack(getPriority(), done); }
 };
+
+// Tasks are held by the million; keep them within five words.
+static_assert(sizeof(Task) == 40);
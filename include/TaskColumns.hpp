@@ -0,0 +1,48 @@
+#pragma once
+#include "Task.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Column-wise copy of the fields ls filters and sorts on, index-aligned with
+// TaskManager::tasks_. A row's text lives in tasks_ at the same index, so the
+// row number doubles as its text handle.
+class TaskColumns {
+public:
+  static constexpr uint8_t kPriorityMask = Task::kPriorityMask;
+  static constexpr uint8_t kDoneBit = Task::kDoneBit;
+
+private:
+  std::vector<uint64_t> ids_;
+  std::vector<uint8_t> flags_;
+  std::vector<CategoryId> categories_;
+  // collationKey of each task's text, for ls -s text.
+  std::vector<uint64_t> textKeys_;
+
+public:
+  static uint8_t pack(Priority priority, bool done) {
+    return Task::pack(priority, done);
+  }
+  // First 8 bytes of text, lowercased and packed big-endian (zero padded),
+  // so comparing keys compares those prefixes case-insensitively. Equal
+  // keys need a full comparison only when both texts are longer.
+  static uint64_t collationKey(std::string_view text);
+
+  size_t size() const { return ids_.size(); }
+  uint64_t id(size_t row) const { return ids_[row]; }
+  uint8_t flags(size_t row) const { return flags_[row]; }
+  Priority priority(size_t row) const {
+    return static_cast<Priority>(flags_[row] & kPriorityMask);
+  }
+  bool isDone(size_t row) const { return flags_[row] & kDoneBit; }
+  CategoryId category(size_t row) const { return categories_[row]; }
+  uint64_t textKey(size_t row) const { return textKeys_[row]; }
+
+  void assign(const std::vector<Task> &tasks);
+  void push(const Task &task);
+  void insert(size_t row, const Task &task);
+  void erase(size_t row);
+  void setDone(size_t row, bool done);
+  void setText(size_t row, std::string_view text);
+};
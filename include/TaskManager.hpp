@@ -1,20 +1,73 @@
 #pragma once
+#include "Bitmap.hpp"
+#include "CategoryStats.hpp"
 #include "Command.hpp"
+#include "Output.hpp"
+#include "PrefixIndex.hpp"
+#include "Query.hpp"
+#include "QueryCache.hpp"
+#include "QueryTrace.hpp"
+#include "SavedView.hpp"
 #include "Task.hpp"
+#include "TaskColumns.hpp"
+#include "UndoHistory.hpp"
 #include "Utils.hpp"
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <memory_resource>
 #include <optional>
-#include <stack>
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 class TaskManager {
 private:
+  // Text of tasks read by load() is carved out of textArena_ and freed in one
+  // go on clear or reload. Text from add and edit goes to editPool_, which
+  // can reuse freed blocks. Both must outlive tasks_.
+  std::pmr::monotonic_buffer_resource textArena_;
+  std::pmr::unsynchronized_pool_resource editPool_;
   std::vector<Task> tasks_;
+  TaskColumns columns_;
+  // Row bitmaps kept next to columns_ so ls filters combine word by word.
+  Bitmap doneBits_;
+  Bitmap pendingBits_;
+  std::array<Bitmap, 3> priorityBits_;
+  std::unordered_map<uint64_t, size_t> rowById_;
+  CategoryStats categoryStats_;
+  // Reused by every ls so rendering does not reallocate its buffer.
+  mutable std::string renderBuffer_;
   uint64_t nextId_;
   std::string filePath_;
-  std::stack<std::unique_ptr<Command>> stack_;
+  // Undone commands wait in redo_ until the next new command.
+  UndoHistory history_;
+  UndoHistory redo_;
+  // Lowercased copy of each task's text, index-aligned with tasks_. Only
+  // populated while foldCache_ is on.
+  std::vector<std::string> foldedText_;
+  bool foldCache_;
+  ColorMode colorMode_;
+  size_t pageSize_;
+  // ls filters candidate lists of at least parallelThreshold_ rows on
+  // threads_ threads.
+  size_t threads_;
+  size_t parallelThreshold_;
+  // Bumped by every change to tasks_; cached ls results are only valid for
+  // the version they were computed at.
+  uint64_t version_;
+  mutable QueryCache queryCache_;
+  // Set only while an ls --explain runs.
+  mutable QueryTrace *trace_;
+  std::map<std::string, SavedView> savedViews_;
+  // Built on the first prefix lookup, then kept current by the row
+  // helpers.
+  mutable PrefixIndex prefixIndex_;
+  mutable bool prefixIndexReady_;
 
 public:
   TaskManager(const std::string &filePath);
@@ -29,20 +82,117 @@ public:
   CustomError markDone(const std::string &flag);
   CustomError undone(const std::string &flag);
   void printHelp() const;
+  // Runs a command built in place and keeps it inline for undo, e.g.
+  // execute<DoneCommand>("3").
+  template <typename T, typename... Args> CustomError execute(Args &&...args) {
+    return runCommand(AnyCommand(std::in_place_type<T>, *this,
+                                 std::forward<Args>(args)...));
+  }
+  // For Command subclasses that AnyCommand does not name.
   CustomError executeCommand(std::unique_ptr<Command> command);
   std::optional<bool> getTaskDoneStatus(const std::string &flag) const;
   CustomError setTaskDone(const std::string &flag, bool done);
   std::pair<std::optional<Task>, std::optional<size_t>>
   removeTask(const std::string &flag);
-  std::pair<std::optional<size_t>, std::optional<std::string>>
-  editTask(const std::string &text, size_t idx = std::string::npos);
+  // Returns the edited task's id and its previous text.
+  std::pair<std::optional<uint64_t>, std::optional<std::string>>
+  editTask(const std::string &text);
+  // By-id primitives for commands. Each returns std::nullopt when the task
+  // is gone.
+  std::optional<std::string> replaceTaskText(uint64_t id,
+                                             std::string_view text);
+  std::optional<bool> setTaskDoneById(uint64_t id, bool done);
+  std::optional<std::pair<Task, size_t>> takeTask(uint64_t id);
+  // With byText, input that is not a number names a task by the start of
+  // its words (see completeTaskNumber); several matches are AmbiguousTask.
+  ResolvedId resolveIdFromUserNumber(const std::string &flag,
+                                     bool byText = false) const;
   void undo();
+  void redo();
+  const UndoHistory &undoHistory() const { return history_; }
   std::vector<Task> clearTasks();
   void loadTasks(std::vector<Task> &tasks);
+  CustomError setOption(const std::string &flag);
+  void setFoldCache(bool enabled);
+  bool foldCache() const { return foldCache_; }
+  uint64_t version() const { return version_; }
+  size_t queryCacheHits() const { return queryCache_.hits(); }
+  CustomError saveView(const std::string &flag);
+  CustomError deleteView(const std::string &name);
+  CustomError openView(const std::string &name) const;
+  void listViews() const;
+  void stats() const;
+  void findPrefix(const std::string &flag) const;
+  // Task numbers whose text has words starting with each word of typed,
+  // in list order. Meant to be called as the user types.
+  std::vector<size_t> completeTaskNumber(const std::string &typed) const;
 
 private:
+  CustomError runCommand(AnyCommand &&command);
   CustomError load();
   std::optional<size_t> findIndexById(uint64_t id) const;
-  ResolvedId resolveIdFromUserNumber(const std::string &flag) const;
   ResultIndex parseIndex(const std::string &userInput) const;
+  // ls after parsing.
+  void runLs(const LsQuery &query) const;
+  Bitmap selectByFlags(const LsQuery &query) const;
+  // Rows matching query, in listing order, after --offset and --limit.
+  std::vector<size_t> queryRows(const LsQuery &query,
+                                const Bitmap &selected) const;
+  // Per-row checks behind selectByFlags and the category/--find filters.
+  bool matchesFlags(const LsQuery &query, size_t row) const;
+  bool matchesText(const LsQuery &query, std::optional<CategoryId> category,
+                   size_t row, std::string &scratch) const;
+  void sortRows(std::vector<size_t> &rows, SortKey key) const;
+  // sortRows for SortKey::text; returns how many rows needed a full text
+  // comparison.
+  size_t sortTextTies(std::vector<size_t> &rows) const;
+  // Threads to filter a candidate list of this many rows with.
+  size_t chunksFor(size_t rows) const;
+  // queryRows for --fuzzy: ranked by edit distance unless -s is given.
+  std::vector<size_t> fuzzyRows(const LsQuery &query, const Bitmap &selected,
+                                std::optional<CategoryId> category) const;
+  static void applyWindow(std::vector<size_t> &rows, const LsQuery &query);
+  // applyWindow for ls: skipped under --count, recorded by --explain.
+  void applyWindowTraced(std::vector<size_t> &rows,
+                         const LsQuery &query) const;
+  void renderRows(std::span<const size_t> rows, const LsQuery &query,
+                  size_t firstNumber) const;
+  void printRows(std::span<const size_t> rows, bool color,
+                 size_t firstNumber) const;
+  void printJsonRows(std::span<const size_t> rows) const;
+  // ls --group category: rows regrouped by category name, each group in
+  // listing order.
+  void renderGroups(std::span<const size_t> rows, const LsQuery &query,
+                    size_t firstNumber) const;
+  // One "name: count" line per category with a non-zero count.
+  void printGroupCounts(const std::vector<uint32_t> &perCategory) const;
+  void pageRows(const LsQuery &query) const;
+  // queryRows behind the result cache.
+  std::vector<size_t> findRows(const LsQuery &query) const;
+  bool useColor(const LsQuery &query) const;
+  const std::string &foldedText(size_t index, std::string &scratch) const;
+  // Every change to tasks_ goes through these so that derived per-task data
+  // stays aligned with it.
+  void appendTask(Task task);
+  void insertTask(size_t index, const Task &task);
+  void eraseTask(size_t index);
+  void setTaskText(size_t index, const std::string &text);
+  void setTaskDoneAt(size_t index, bool done);
+  void rebuildIndexes();
+  // ls -s done lists done tasks first.
+  static uint8_t doneSortKey(bool done) { return done ? 0 : 1; }
+  void renumberRows(size_t from);
+  // Parses ls options into a view with no members yet.
+  static std::optional<SavedView> compileView(const std::string &options);
+  // Saved view membership for one row, or for all rows after a rebuild.
+  void refreshSavedViews(size_t index);
+  void dropFromSavedViews(uint64_t id);
+  void rebuildSavedView(SavedView &view);
+  bool inSavedView(const SavedView &view, size_t index,
+                   std::string &scratch) const;
+  const PrefixIndex &prefixIndex() const;
+  // Rows having a word that starts with each word of text, in list order.
+  std::vector<size_t> rowsWithPrefixes(const std::string &text) const;
+  // Only valid once no task in tasks_ uses either resource.
+  void releaseTextStorage();
 };
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+
+// Immutable string sized for task text. Up to kInlineCapacity bytes are
+// stored in place, which covers most todo entries; longer text lives in a
+// block from the given memory resource. The object has byte alignment so it
+// packs tightly into Task.
+class TaskText {
+public:
+  static constexpr size_t kInlineCapacity = 28;
+
+private:
+  static constexpr uint8_t kLargeTag = 0xFF;
+  // Inline: bytes_[0..size) hold the text and bytes_[kInlineCapacity] the
+  // size. Large: bytes_ starts with the data pointer, the resource pointer and
+  // a 32-bit size, and the last byte is kLargeTag.
+  unsigned char bytes_[kInlineCapacity + 1];
+
+  bool isLarge() const { return bytes_[kInlineCapacity] == kLargeTag; }
+  const char *largeData() const;
+  std::pmr::memory_resource *largeResource() const;
+  uint32_t largeSize() const;
+  void assign(std::string_view text, std::pmr::memory_resource *resource);
+  void release();
+  void steal(TaskText &other);
+
+public:
+  explicit TaskText(std::string_view text = {},
+                    std::pmr::memory_resource *resource =
+                        std::pmr::get_default_resource());
+  // Copies always allocate from the default resource so they can outlive
+  // the owner of the original's resource.
+  TaskText(const TaskText &other);
+  TaskText(TaskText &&other) noexcept;
+  TaskText &operator=(const TaskText &other);
+  // Takes over other's block and resource.
+  TaskText &operator=(TaskText &&other) noexcept;
+  ~TaskText() { release(); }
+
+  std::string_view view() const;
+  size_t size() const { return view().size(); }
+};
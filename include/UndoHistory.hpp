@@ -0,0 +1,50 @@
+#pragma once
+#include "Command.hpp"
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+// Executed commands, newest last, held inline in a ring that grows as
+// needed up to depth entries. Once the depth or the byte budget (the sum of
+// the commands' footprints) is exceeded the oldest entries are dropped.
+// Depth 0 turns the history off.
+class UndoHistory {
+private:
+  struct Entry {
+    std::optional<AnyCommand> command;
+    size_t bytes = 0;
+  };
+  std::vector<Entry> ring_;
+  size_t depth_;
+  // Slot of the oldest entry.
+  size_t head_ = 0;
+  size_t size_ = 0;
+  size_t bytes_ = 0;
+  size_t budget_;
+  size_t evicted_ = 0;
+
+  Entry &slot(size_t age) { return ring_[(head_ + age) % ring_.size()]; }
+  void dropOldest();
+  // Moves the entries, oldest first, into a ring of this many slots.
+  void resize(size_t slots);
+
+public:
+  UndoHistory(size_t depth, size_t budget);
+
+  // Keeps command, evicting old entries to make room. Returns false when
+  // the history is off or the command alone is larger than the budget;
+  // only the latter counts as an eviction.
+  bool push(AnyCommand &&command);
+  // Newest command, or std::nullopt when empty.
+  std::optional<AnyCommand> pop();
+  void setLimits(size_t depth, size_t budget);
+  // Drops every entry without counting it as evicted.
+  void clear();
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  size_t bytes() const { return bytes_; }
+  size_t depth() const { return depth_; }
+  size_t budget() const { return budget_; }
+  // Entries dropped so far to stay within the limits.
+  size_t evicted() const { return evicted_; }
+};
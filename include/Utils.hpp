@@ -2,8 +2,17 @@
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 
-enum class CustomError { Ok, InvalidNumber, NoSuchTask, ParseError, IoError };
+enum class CustomError {
+  Ok,
+  InvalidNumber,
+  NoSuchTask,
+  ParseError,
+  IoError,
+  NoSuchView,
+  AmbiguousTask
+};
 struct ResultIndex {
   CustomError code;
   size_t index = 0;
@@ -12,6 +21,6 @@ struct ResolvedId {
   CustomError code = CustomError::InvalidNumber;
   std::optional<uint64_t> id;
 };
-std::string stringToLower(const std::string &text);
+std::string stringToLower(std::string_view text);
 void printError(const CustomError &err);
 std::string trim(const std::string &userInput);
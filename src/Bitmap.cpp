@@ -0,0 +1,84 @@
+#include "../include/Bitmap.hpp"
+#include <algorithm>
+
+namespace {
+uint64_t lowMask(size_t bits) { return (uint64_t{1} << bits) - 1; }
+} // namespace
+
+Bitmap::Bitmap(size_t size, bool value)
+    : words_((size + 63) / 64, value ? ~uint64_t{0} : 0), size_(size) {
+  if (value && size % 64 != 0) {
+    words_.back() &= lowMask(size % 64);
+  }
+}
+void Bitmap::set(size_t pos, bool value) {
+  const uint64_t bit = uint64_t{1} << (pos % 64);
+  if (value) {
+    words_[pos / 64] |= bit;
+  } else {
+    words_[pos / 64] &= ~bit;
+  }
+}
+void Bitmap::push(bool value) {
+  if (size_ % 64 == 0) {
+    words_.push_back(0);
+  }
+  set(size_++, value);
+}
+void Bitmap::insert(size_t pos, bool value) {
+  if (size_ % 64 == 0) {
+    words_.push_back(0);
+  }
+  ++size_;
+  const size_t word = pos / 64;
+  for (size_t i = words_.size() - 1; i > word; --i) {
+    words_[i] = (words_[i] << 1) | (words_[i - 1] >> 63);
+  }
+  const uint64_t low = words_[word] & lowMask(pos % 64);
+  const uint64_t high = (words_[word] & ~lowMask(pos % 64)) << 1;
+  words_[word] = low | high;
+  set(pos, value);
+}
+void Bitmap::erase(size_t pos) {
+  const size_t word = pos / 64;
+  const uint64_t low = words_[word] & lowMask(pos % 64);
+  const uint64_t high = (words_[word] >> 1) & ~lowMask(pos % 64);
+  words_[word] = low | high;
+  for (size_t i = word; i + 1 < words_.size(); ++i) {
+    words_[i] |= words_[i + 1] << 63;
+    words_[i + 1] >>= 1;
+  }
+  --size_;
+  if (size_ % 64 == 0) {
+    words_.pop_back();
+  }
+}
+void Bitmap::clear() {
+  words_.clear();
+  size_ = 0;
+}
+size_t Bitmap::count() const {
+  size_t total = 0;
+  for (uint64_t word : words_) {
+    total += std::popcount(word);
+  }
+  return total;
+}
+Bitmap &Bitmap::operator&=(const Bitmap &other) {
+  for (size_t i = 0; i < words_.size(); ++i) {
+    words_[i] &= other.words_[i];
+  }
+  return *this;
+}
+Bitmap &Bitmap::operator|=(const Bitmap &other) {
+  for (size_t i = 0; i < words_.size(); ++i) {
+    words_[i] |= other.words_[i];
+  }
+  return *this;
+}
+void Bitmap::appendSetBits(std::vector<size_t> &out) const {
+  forEachSetBit([&out](size_t pos) {
+    out.push_back(pos);
+    return true;
+  });
+}
@@ -0,0 +1,48 @@
+#include "../include/Category.hpp"
+#include "../include/Utils.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+CategoryTable &CategoryTable::shared() {
+  static CategoryTable table;
+  return table;
+}
+CategoryId CategoryTable::intern(std::string_view name) {
+  auto it = ids_.find(name);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+  if (names_.size() > std::numeric_limits<CategoryId>::max()) {
+    throw std::length_error("too many categories");
+  }
+  const CategoryId id = static_cast<CategoryId>(names_.size());
+  names_.emplace_back(name);
+  ids_.emplace(names_.back(), id);
+  return id;
+}
+std::optional<CategoryId> CategoryTable::find(std::string_view name) const {
+  auto it = ids_.find(name);
+  if (it == ids_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+std::vector<CategoryId> CategoryTable::idsByName() const {
+  std::vector<CategoryId> ids(names_.size());
+  for (size_t id = 0; id < ids.size(); ++id) {
+    ids[id] = static_cast<CategoryId>(id);
+  }
+  // Case-folded like ls -s text; the raw name breaks ties.
+  std::vector<std::string> folded;
+  folded.reserve(names_.size());
+  for (const std::string &name : names_) {
+    folded.push_back(stringToLower(name));
+  }
+  std::ranges::sort(ids, [&](CategoryId a, CategoryId b) {
+    return std::tie(folded[a], names_[a]) < std::tie(folded[b], names_[b]);
+  });
+  return ids;
+}
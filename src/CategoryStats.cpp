@@ -0,0 +1,20 @@
+#include "../include/CategoryStats.hpp"
+#include <numeric>
+
+void CategoryStats::add(CategoryId category, uint8_t flags) {
+  if (category >= counts_.size()) {
+    counts_.resize(category + 1, Counts{});
+  }
+  ++counts_[category][flags];
+}
+void CategoryStats::remove(CategoryId category, uint8_t flags) {
+  --counts_[category][flags];
+}
+const CategoryStats::Counts &CategoryStats::counts(CategoryId category) const {
+  static const Counts none{};
+  return category < counts_.size() ? counts_[category] : none;
+}
+uint32_t CategoryStats::total(CategoryId category) const {
+  const Counts &byFlags = counts(category);
+  return std::accumulate(byFlags.begin(), byFlags.end(), uint32_t{0});
+}
@@ -2,82 +2,140 @@
 #include "../include/TaskManager.hpp"
 #include <cstdint>
 #include <optional>
+#include <utility>
+
+namespace {
+size_t heapBytes(const std::string &text) {
+  // Short strings live inside the object.
+  return text.capacity() > std::string().capacity() ? text.capacity() : 0;
+}
+size_t heapBytes(const TaskText &text) {
+  const size_t size = text.view().size();
+  return size > TaskText::kInlineCapacity ? size : 0;
+}
+size_t heapBytes(const Task &task) {
+  const size_t size = task.getText().size();
+  return size > TaskText::kInlineCapacity ? size : 0;
+}
+// The typed input is only needed until execute has resolved it.
+void release(std::string &text) { std::string().swap(text); }
+CustomError setDone(TaskManager &manager, std::string &text, bool done,
+                    uint64_t &id, bool &previousDone) {
+  ResolvedId rid = manager.resolveIdFromUserNumber(text, true);
+  if (rid.code != CustomError::Ok) {
+    return rid.code;
+  }
+  std::optional<bool> previous = manager.setTaskDoneById(*rid.id, done);
+  if (!previous) {
+    return CustomError::NoSuchTask;
+  }
+  id = *rid.id;
+  previousDone = *previous;
+  release(text);
+  return CustomError::Ok;
+}
+} // namespace
 
 AddCommand::AddCommand(TaskManager &manager, const std::string &text)
-    : manager_(manager), text_(text) {}
+    : manager_(manager), text_(text), id_(0), index_(0) {}
 CustomError AddCommand::execute() {
   std::optional<uint64_t> id = manager_.add(text_);
-  if (id) {
-    id_ = *id;
-    return CustomError::Ok;
+  if (!id) {
+    return CustomError::InvalidNumber;
   }
-  return CustomError::InvalidNumber;
+  id_ = *id;
+  release(text_);
+  return CustomError::Ok;
 }
 CustomError AddCommand::undo() {
-  auto isOk = manager_.removeById(id_);
-  if (isOk) {
-    return CustomError::Ok;
+  auto taken = manager_.takeTask(id_);
+  if (!taken) {
+    return CustomError::NoSuchTask;
   }
-  return CustomError::NoSuchTask;
+  task_ = std::move(taken->first);
+  index_ = taken->second;
+  return CustomError::Ok;
+}
+CustomError AddCommand::redo() {
+  if (!task_ || !manager_.insertByIndex(*task_, index_)) {
+    return CustomError::NoSuchTask;
+  }
+  task_.reset();
+  return CustomError::Ok;
+}
+size_t AddCommand::footprint() const {
+  return sizeof(*this) + heapBytes(text_) + (task_ ? heapBytes(*task_) : 0);
 }
 
 EditCommand::EditCommand(TaskManager &manager, const std::string &text)
-    : manager_(manager), text_(text) {}
+    : manager_(manager), text_(text), id_(0) {}
 CustomError EditCommand::execute() {
-  auto pair = manager_.editTask(text_);
-  if (pair.first && pair.second) {
-    idx_ = *pair.first;
-    previousText_ = *pair.second;
-    return CustomError::Ok;
+  auto [id, previousText] = manager_.editTask(text_);
+  if (!id || !previousText) {
+    return CustomError::InvalidNumber;
   }
-  return CustomError::InvalidNumber;
+  id_ = *id;
+  otherText_ = TaskText(*previousText);
+  release(text_);
+  return CustomError::Ok;
 }
 CustomError EditCommand::undo() {
-  auto pair = manager_.editTask(previousText_, idx_);
-  if (pair.first && pair.second) {
-    idx_ = *pair.first;
-    previousText_ = *pair.second;
-    return CustomError::Ok;
+  std::optional<std::string> replaced =
+      manager_.replaceTaskText(id_, otherText_.view());
+  if (!replaced) {
+    return CustomError::NoSuchTask;
   }
-  return CustomError::InvalidNumber;
+  otherText_ = TaskText(*replaced);
+  return CustomError::Ok;
+}
+CustomError EditCommand::redo() { return undo(); }
+size_t EditCommand::footprint() const {
+  return sizeof(*this) + heapBytes(text_) + heapBytes(otherText_);
 }
 
 DoneCommand::DoneCommand(TaskManager &manager, const std::string &text)
-    : manager_(manager), text_(text) {}
+    : manager_(manager), text_(text), id_(0), previousDone_(false) {}
 CustomError DoneCommand::execute() {
-  std::optional<bool> isDone = manager_.getTaskDoneStatus(text_);
-  if (isDone == std::nullopt) {
-    return CustomError::NoSuchTask;
-  }
-  previousDone_ = *isDone;
-  return manager_.setTaskDone(text_, true);
+  return setDone(manager_, text_, true, id_, previousDone_);
 }
 CustomError DoneCommand::undo() {
-  return manager_.setTaskDone(text_, previousDone_);
+  return manager_.setTaskDoneById(id_, previousDone_) ? CustomError::Ok
+                                                      : CustomError::NoSuchTask;
+}
+CustomError DoneCommand::redo() {
+  return manager_.setTaskDoneById(id_, true) ? CustomError::Ok
+                                             : CustomError::NoSuchTask;
+}
+size_t DoneCommand::footprint() const {
+  return sizeof(*this) + heapBytes(text_);
 }
 
 UndoneCommand::UndoneCommand(TaskManager &manager, const std::string &text)
-    : manager_(manager), text_(text) {}
+    : manager_(manager), text_(text), id_(0), previousDone_(false) {}
 CustomError UndoneCommand::execute() {
-  std::optional<bool> isDone = manager_.getTaskDoneStatus(text_);
-  if (isDone == std::nullopt) {
-    return CustomError::NoSuchTask;
-  }
-  previousDone_ = *isDone;
-  return manager_.setTaskDone(text_, false);
+  return setDone(manager_, text_, false, id_, previousDone_);
 }
 CustomError UndoneCommand::undo() {
-  return manager_.setTaskDone(text_, previousDone_);
+  return manager_.setTaskDoneById(id_, previousDone_) ? CustomError::Ok
+                                                      : CustomError::NoSuchTask;
+}
+CustomError UndoneCommand::redo() {
+  return manager_.setTaskDoneById(id_, false) ? CustomError::Ok
+                                              : CustomError::NoSuchTask;
+}
+size_t UndoneCommand::footprint() const {
+  return sizeof(*this) + heapBytes(text_);
 }
 
 DelCommand::DelCommand(TaskManager &manager, const std::string &text)
-    : manager_(manager), text_(text), task_(Task(0, "")) {}
+    : manager_(manager), text_(text), task_(Task(0, "")), index_(0) {}
 CustomError DelCommand::execute() {
   std::pair<std::optional<Task>, std::optional<size_t>> pair =
       manager_.removeTask(text_);
   if (pair.first && pair.second) {
     task_ = *pair.first;
     index_ = *pair.second;
+    release(text_);
     return CustomError::Ok;
   }
   return CustomError::NoSuchTask;
@@ -89,6 +147,13 @@ CustomError DelCommand::undo() {
   }
   return CustomError::NoSuchTask;
 }
+CustomError DelCommand::redo() {
+  return manager_.takeTask(task_.getId()) ? CustomError::Ok
+                                          : CustomError::NoSuchTask;
+}
+size_t DelCommand::footprint() const {
+  return sizeof(*this) + heapBytes(text_) + heapBytes(task_);
+}
 
 ClearCommand::ClearCommand(TaskManager &manager)
     : manager_(manager), previousTasks_({}) {}
@@ -98,5 +163,14 @@ CustomError ClearCommand::execute() {
 }
 CustomError ClearCommand::undo() {
   manager_.loadTasks(previousTasks_);
+  std::vector<Task>().swap(previousTasks_);
   return CustomError::Ok;
 }
+CustomError ClearCommand::redo() { return execute(); }
+size_t ClearCommand::footprint() const {
+  size_t bytes = sizeof(*this) + previousTasks_.capacity() * sizeof(Task);
+  for (const Task &task : previousTasks_) {
+    bytes += heapBytes(task);
+  }
+  return bytes;
+}
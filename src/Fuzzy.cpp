@@ -0,0 +1,46 @@
+#include "../include/Fuzzy.hpp"
+#include <algorithm>
+
+FuzzyPattern::FuzzyPattern(std::string_view pattern)
+    : length_(static_cast<unsigned>(pattern.size())),
+      maxErrors_(std::min(3u, length_ / 4)) {
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    masks_[static_cast<unsigned char>(pattern[i])] |= uint64_t{1} << i;
+  }
+}
+unsigned FuzzyPattern::distance(std::string_view text) const {
+  const unsigned miss = maxErrors_ + 1;
+  if (text.size() + maxErrors_ < length_) {
+    return miss;
+  }
+  // Column of the DP table stored as vertical +1/-1 deltas. A match may
+  // start anywhere, so the top row stays 0 and nothing is shifted in.
+  const uint64_t last = uint64_t{1} << (length_ - 1);
+  uint64_t pv = ~uint64_t{0};
+  uint64_t mv = 0;
+  unsigned score = length_;
+  unsigned best = length_;
+  for (unsigned char c : text) {
+    const uint64_t eq = masks_[c];
+    const uint64_t xv = eq | mv;
+    const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+    uint64_t ph = mv | ~(xh | pv);
+    uint64_t mh = pv & xh;
+    if (ph & last) {
+      ++score;
+    } else if (mh & last) {
+      --score;
+    }
+    ph <<= 1;
+    mh <<= 1;
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+    if (score < best) {
+      best = score;
+      if (best == 0) {
+        break;
+      }
+    }
+  }
+  return std::min(best, miss);
+}
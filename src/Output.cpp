@@ -0,0 +1,52 @@
+#include "../include/Output.hpp"
+#include <unistd.h>
+
+bool stdoutIsTerminal() { return isatty(STDOUT_FILENO) == 1; }
+
+OutputBuffer::OutputBuffer(std::ostream &os, std::string &storage,
+                           size_t threshold)
+    : os_(os), buffer_(storage), threshold_(threshold) {
+  buffer_.clear();
+  buffer_.reserve(threshold_ + 256);
+}
+void OutputBuffer::flush() {
+  if (!buffer_.empty()) {
+    os_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+  os_.flush();
+}
+void writeJsonString(OutputBuffer &out, std::string_view text) {
+  static const char hex[] = "0123456789abcdef";
+  out << '"';
+  size_t plain = 0;
+  for (size_t i = 0; i < text.size(); ++i) {
+    const unsigned char c = static_cast<unsigned char>(text[i]);
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+    out << text.substr(plain, i - plain);
+    plain = i + 1;
+    switch (c) {
+    case '"':
+      out << "\\\"";
+      break;
+    case '\\':
+      out << "\\\\";
+      break;
+    case '\n':
+      out << "\\n";
+      break;
+    case '\t':
+      out << "\\t";
+      break;
+    case '\r':
+      out << "\\r";
+      break;
+    default:
+      out << "\\u00" << hex[c >> 4] << hex[c & 0xF];
+      break;
+    }
+  }
+  out << text.substr(plain) << '"';
+}
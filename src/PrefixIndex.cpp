@@ -0,0 +1,51 @@
+#include "../include/PrefixIndex.hpp"
+#include <cctype>
+
+namespace {
+bool isWordByte(unsigned char c) { return c >= 0x80 || std::isalnum(c); }
+} // namespace
+
+std::vector<std::string_view> indexWords(std::string_view folded) {
+  std::vector<std::string_view> words;
+  size_t i = 0;
+  while (i < folded.size()) {
+    while (i < folded.size() && !isWordByte(folded[i])) {
+      ++i;
+    }
+    const size_t start = i;
+    while (i < folded.size() && isWordByte(folded[i])) {
+      ++i;
+    }
+    if (i > start) {
+      words.push_back(folded.substr(start, i - start));
+    }
+  }
+  return words;
+}
+
+void PrefixIndex::add(uint64_t id, std::string_view folded) {
+  for (std::string_view word : indexWords(folded)) {
+    entries_.emplace(std::string(word), id);
+  }
+}
+void PrefixIndex::remove(uint64_t id, std::string_view folded) {
+  for (std::string_view word : indexWords(folded)) {
+    entries_.erase(Entry(std::string(word), id));
+  }
+}
+PrefixIndex::Iterator PrefixIndex::endOf(std::string_view prefix) const {
+  // First word past every word with this prefix: bump the last byte that
+  // can be bumped and drop what follows it.
+  std::string next(prefix);
+  while (!next.empty() && static_cast<unsigned char>(next.back()) == 0xff) {
+    next.pop_back();
+  }
+  if (next.empty()) {
+    return entries_.end();
+  }
+  ++next.back();
+  return entries_.lower_bound(Entry(next, 0));
+}
+PrefixIndex::Range PrefixIndex::find(std::string_view prefix) const {
+  return {entries_.lower_bound(Entry(prefix, 0)), endOf(prefix)};
+}
@@ -0,0 +1,176 @@
+#include "../include/Query.hpp"
+#include "../include/Fuzzy.hpp"
+#include "../include/Task.hpp"
+#include "../include/Utils.hpp"
+#include <charconv>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace {
+uint8_t priorityBit(Priority priority) {
+  return static_cast<uint8_t>(1u << static_cast<unsigned>(priority));
+}
+std::optional<size_t> parseCount(const std::string &text) {
+  size_t value;
+  auto [ptr, err] =
+      std::from_chars(text.data(), text.data() + text.size(), value);
+  if (err != std::errc() || ptr != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+} // namespace
+
+std::optional<LsQuery> parseLsQuery(const std::string &flag) {
+  std::istringstream stream(flag);
+  std::vector<std::string> tokens;
+  std::string token;
+  while (stream >> token) {
+    tokens.push_back(token);
+  }
+
+  LsQuery query;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    const std::string &option = tokens[i];
+    if (option == "-d" || option == "--done") {
+      query.done = true;
+    } else if (option == "-p" || option == "--pending") {
+      query.done = false;
+    } else if (option == "-l" || option == "--low") {
+      query.priorities |= priorityBit(Priority::low);
+    } else if (option == "-m" || option == "--medium") {
+      query.priorities |= priorityBit(Priority::medium);
+    } else if (option == "-h" || option == "--high") {
+      query.priorities |= priorityBit(Priority::high);
+    } else if (option == "-c" || option == "--category") {
+      if (i + 1 == tokens.size()) {
+        return std::nullopt;
+      }
+      query.category = tokens[++i];
+    } else if (option == "--limit" || option == "--offset") {
+      if (i + 1 == tokens.size()) {
+        return std::nullopt;
+      }
+      std::optional<size_t> value = parseCount(tokens[++i]);
+      if (!value) {
+        return std::nullopt;
+      }
+      if (option == "--limit") {
+        query.limit = *value;
+      } else {
+        query.offset = *value;
+      }
+    } else if (option == "--format" || option.starts_with("--format=")) {
+      std::string name;
+      if (option == "--format") {
+        if (i + 1 == tokens.size()) {
+          return std::nullopt;
+        }
+        name = tokens[++i];
+      } else {
+        name = option.substr(std::string("--format=").size());
+      }
+      if (name == "human") {
+        query.format = OutputFormat::human;
+      } else if (name == "jsonl") {
+        query.format = OutputFormat::jsonl;
+      } else {
+        return std::nullopt;
+      }
+    } else if (option == "--group") {
+      if (i + 1 == tokens.size() || tokens[++i] != "category") {
+        return std::nullopt;
+      }
+      query.group = GroupKey::category;
+    } else if (option == "--explain") {
+      query.explain = true;
+    } else if (option == "--pager") {
+      query.pager = true;
+    } else if (option == "--plain") {
+      query.plain = true;
+    } else if (option == "--count") {
+      query.count = true;
+    } else if (option == "-s" || option == "--sort") {
+      if (i + 1 == tokens.size()) {
+        return std::nullopt;
+      }
+      const std::string &key = tokens[++i];
+      if (key == "id") {
+        query.sort = SortKey::id;
+      } else if (key == "done") {
+        query.sort = SortKey::done;
+      } else if (key == "priority") {
+        query.sort = SortKey::priority;
+      } else if (key == "text") {
+        query.sort = SortKey::text;
+      } else if (key == "category") {
+        query.sort = SortKey::category;
+      } else {
+        return std::nullopt;
+      }
+    } else if (option == "-f" || option == "--find" ||
+               option == "--fuzzy" || option == "--regex") {
+      // The search text runs up to the next option, so multi-word searches
+      // need no quoting.
+      std::string text;
+      while (i + 1 < tokens.size() && tokens[i + 1][0] != '-') {
+        if (!text.empty()) {
+          text += ' ';
+        }
+        text += tokens[++i];
+      }
+      if (text.empty()) {
+        return std::nullopt;
+      }
+      if (option == "--regex") {
+        std::optional<RegexFilter> regex = RegexFilter::compile(text);
+        if (!regex) {
+          return std::nullopt;
+        }
+        query.regex = std::make_shared<const RegexFilter>(std::move(*regex));
+      } else if (option == "--fuzzy") {
+        if (text.size() > FuzzyPattern::kMaxLength) {
+          return std::nullopt;
+        }
+        query.fuzzy = stringToLower(text);
+      } else {
+        query.find = stringToLower(text);
+      }
+    } else {
+      return std::nullopt;
+    }
+  }
+  return query;
+}
+bool flagsMatch(const LsQuery &query, uint8_t flags) {
+  if (query.done && ((flags & Task::kDoneBit) != 0) != *query.done) {
+    return false;
+  }
+  return query.priorities == 0 ||
+         (query.priorities & (1u << (flags & Task::kPriorityMask)));
+}
+std::string normalizedKey(const LsQuery &query) {
+  std::string key;
+  key += query.done ? (*query.done ? 'd' : 'p') : '-';
+  key += static_cast<char>('0' + query.priorities);
+  key += static_cast<char>('0' + static_cast<int>(query.sort));
+  key += query.count ? 'n' : '-';
+  key += ';';
+  if (query.limit) {
+    key += std::to_string(*query.limit);
+  }
+  key += ';' + std::to_string(query.offset) + ';';
+  // Free text goes last, length-prefixed, so no separator can be forged.
+  if (query.category) {
+    key += std::to_string(query.category->size()) + ':' + *query.category;
+  }
+  key += ';' + std::to_string(query.fuzzy.size()) + ':' + query.fuzzy + ';';
+  if (query.regex) {
+    const std::string &pattern = query.regex->pattern();
+    key += std::to_string(pattern.size()) + ':' + pattern;
+  }
+  key += ';' + query.find;
+  return key;
+}
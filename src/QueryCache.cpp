@@ -0,0 +1,38 @@
+#include "../include/QueryCache.hpp"
+
+const std::vector<size_t> *QueryCache::find(const std::string &key,
+                                            uint64_t version) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  if (it->second->version != version) {
+    entries_.erase(it->second);
+    index_.erase(it);
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  ++hits_;
+  return &entries_.front().rows;
+}
+void QueryCache::insert(const std::string &key, uint64_t version,
+                        const std::vector<size_t> &rows) {
+  if (capacity_ == 0) {
+    return;
+  }
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+  entries_.push_front({key, version, rows});
+  index_[key] = entries_.begin();
+  setCapacity(capacity_);
+}
+void QueryCache::setCapacity(size_t capacity) {
+  capacity_ = capacity;
+  while (entries_.size() > capacity_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
@@ -0,0 +1,35 @@
+#include "../include/QueryTrace.hpp"
+#include <iomanip>
+#include <utility>
+
+void QueryTrace::stage(std::string name, std::string detail,
+                       std::optional<size_t> rows) {
+  const Clock::time_point now = Clock::now();
+  const std::chrono::duration<double, std::milli> took = now - last_;
+  stages_.push_back({std::move(name), std::move(detail), rows, took.count()});
+  last_ = now;
+}
+void QueryTrace::print(std::ostream &out) const {
+  const std::chrono::duration<double, std::milli> total = last_ - started_;
+  const std::ios::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out << "-- plan --\n"
+      << std::left << std::setw(8) << "stage" << std::right << std::setw(10)
+      << "rows" << std::setw(11) << "ms"
+      << "  detail\n"
+      << std::fixed << std::setprecision(3);
+  for (const Stage &stage : stages_) {
+    out << std::left << std::setw(8) << stage.name << std::right
+        << std::setw(10);
+    if (stage.rows) {
+      out << *stage.rows;
+    } else {
+      out << '-';
+    }
+    out << std::setw(11) << stage.ms << "  " << stage.detail << '\n';
+  }
+  out << std::left << std::setw(8) << "total" << std::right << std::setw(10)
+      << "" << std::setw(11) << total.count() << '\n';
+  out.flags(flags);
+  out.precision(precision);
+}
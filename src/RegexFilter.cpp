@@ -0,0 +1,141 @@
+#include "../include/RegexFilter.hpp"
+#include "../include/Utils.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <utility>
+
+namespace {
+bool isQuantifier(char c) {
+  return c == '*' || c == '+' || c == '?' || c == '{';
+}
+// Characters after \x, \u and \c that belong to the escape.
+size_t escapePayload(char escaped) {
+  switch (escaped) {
+  case 'x':
+    return 2;
+  case 'u':
+    return 4;
+  case 'c':
+    return 1;
+  default:
+    return 0;
+  }
+}
+} // namespace
+
+std::vector<std::string> requiredLiterals(std::string_view pattern) {
+  std::vector<std::string> literals;
+  std::string run;
+  auto endRun = [&]() {
+    if (!run.empty()) {
+      literals.push_back(std::move(run));
+      run.clear();
+    }
+  };
+
+  int depth = 0;
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const char c = pattern[i];
+    if (c == '\\' && i + 1 < pattern.size()) {
+      const char escaped = pattern[++i];
+      i = std::min(i + escapePayload(escaped), pattern.size() - 1);
+      // Escaped letters and digits are classes, assertions or back
+      // references; escaped punctuation is the character itself.
+      if (depth > 0 || std::isalnum(static_cast<unsigned char>(escaped))) {
+        endRun();
+        continue;
+      }
+      if (i + 1 < pattern.size() && isQuantifier(pattern[i + 1])) {
+        endRun();
+        continue;
+      }
+      run += escaped;
+      continue;
+    }
+    if (c == '[') {
+      // Skip the class; ']' right after '[' or '[^' is a literal member.
+      endRun();
+      size_t j = i + 1;
+      if (j < pattern.size() && pattern[j] == '^') {
+        ++j;
+      }
+      if (j < pattern.size() && pattern[j] == ']') {
+        ++j;
+      }
+      while (j < pattern.size() && pattern[j] != ']') {
+        j += pattern[j] == '\\' ? 2 : 1;
+      }
+      i = j;
+      continue;
+    }
+    if (c == '(') {
+      ++depth;
+      endRun();
+      continue;
+    }
+    if (c == ')') {
+      depth = std::max(0, depth - 1);
+      continue;
+    }
+    if (c == '|' && depth == 0) {
+      return {};
+    }
+    if (depth > 0) {
+      continue;
+    }
+    if (c == '{') {
+      // A counted quantifier; the atom before it was already left out.
+      endRun();
+      while (i + 1 < pattern.size() && pattern[i] != '}') {
+        ++i;
+      }
+      continue;
+    }
+    if (std::strchr(".^$|*+?{}", c)) {
+      endRun();
+      continue;
+    }
+    if (i + 1 < pattern.size() && isQuantifier(pattern[i + 1])) {
+      // "ab*" only guarantees "a"; "ab+" guarantees "ab" but nothing
+      // after it is adjacent.
+      if (pattern[i + 1] == '+') {
+        run += c;
+      }
+      endRun();
+      continue;
+    }
+    run += c;
+  }
+  endRun();
+  return literals;
+}
+
+RegexFilter::RegexFilter(std::string pattern, std::regex regex)
+    : pattern_(std::move(pattern)), regex_(std::move(regex)) {
+  for (const std::string &literal : requiredLiterals(pattern_)) {
+    literals_.push_back(stringToLower(literal));
+  }
+  std::ranges::stable_sort(literals_, [](const auto &a, const auto &b) {
+    return a.size() > b.size();
+  });
+}
+std::optional<RegexFilter> RegexFilter::compile(const std::string &pattern) {
+  try {
+    return RegexFilter(pattern,
+                       std::regex(pattern, std::regex::ECMAScript |
+                                               std::regex::icase |
+                                               std::regex::optimize));
+  } catch (const std::regex_error &) {
+    return std::nullopt;
+  }
+}
+bool RegexFilter::matches(std::string_view text,
+                          std::string_view folded) const {
+  for (const std::string &literal : literals_) {
+    if (folded.find(literal) == std::string_view::npos) {
+      return false;
+    }
+  }
+  return std::regex_search(text.data(), text.data() + text.size(), regex_);
+}
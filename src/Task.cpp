@@ -1,15 +1,19 @@
 #include "../include/Task.hpp"
-std::string Task::getPriorityString() const {
-  if (priority_ == Priority::low) {
+std::string_view priorityName(Priority priority) {
+  if (priority == Priority::low) {
     return "low";
-  } else if (priority_ == Priority::medium) {
+  } else if (priority == Priority::medium) {
     return "medium";
-  } else if (priority_ == Priority::high) {
+  } else if (priority == Priority::high) {
     return "high";
   }
   return "low";
 }
-Task::Task(uint64_t id, const std::string &text, const std::string &category,
-           const Priority priority, bool done)
-    : id_(id), text_(text), category_(category), priority_(priority),
-      done_(done) {}
+std::string Task::getPriorityString() const {
+  return std::string(priorityName(getPriority()));
+}
+Task::Task(uint64_t id, std::string_view text, const std::string &category,
+           const Priority priority, bool done,
+           std::pmr::memory_resource *resource)
+    : id_(id), text_(text, resource), flags_(pack(priority, done)),
+      categoryId_(CategoryTable::shared().intern(category)) {}
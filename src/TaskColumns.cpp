@@ -0,0 +1,52 @@
+#include "../include/TaskColumns.hpp"
+#include <cctype>
+
+void TaskColumns::assign(const std::vector<Task> &tasks) {
+  ids_.clear();
+  flags_.clear();
+  categories_.clear();
+  textKeys_.clear();
+  ids_.reserve(tasks.size());
+  flags_.reserve(tasks.size());
+  categories_.reserve(tasks.size());
+  textKeys_.reserve(tasks.size());
+  for (const auto &task : tasks) {
+    push(task);
+  }
+}
+void TaskColumns::push(const Task &task) {
+  ids_.push_back(task.getId());
+  flags_.push_back(task.getFlags());
+  categories_.push_back(task.getCategoryId());
+  textKeys_.push_back(collationKey(task.getText()));
+}
+void TaskColumns::insert(size_t row, const Task &task) {
+  ids_.insert(ids_.begin() + row, task.getId());
+  flags_.insert(flags_.begin() + row, task.getFlags());
+  categories_.insert(categories_.begin() + row, task.getCategoryId());
+  textKeys_.insert(textKeys_.begin() + row, collationKey(task.getText()));
+}
+void TaskColumns::erase(size_t row) {
+  ids_.erase(ids_.begin() + row);
+  flags_.erase(flags_.begin() + row);
+  categories_.erase(categories_.begin() + row);
+  textKeys_.erase(textKeys_.begin() + row);
+}
+void TaskColumns::setDone(size_t row, bool done) {
+  flags_[row] = static_cast<uint8_t>((flags_[row] & ~kDoneBit) |
+                                     (done ? kDoneBit : 0));
+}
+void TaskColumns::setText(size_t row, std::string_view text) {
+  textKeys_[row] = collationKey(text);
+}
+uint64_t TaskColumns::collationKey(std::string_view text) {
+  uint64_t key = 0;
+  for (size_t i = 0; i < 8; ++i) {
+    const unsigned char c =
+        i < text.size() ? static_cast<unsigned char>(std::tolower(
+                              static_cast<unsigned char>(text[i])))
+                        : 0;
+    key = (key << 8) | c;
+  }
+  return key;
+}
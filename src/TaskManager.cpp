@@ -1,37 +1,86 @@
 #include "../include/TaskManager.hpp"
-#include "../include/Color.hpp"
 #include "../include/json.hpp"
 #include <algorithm>
+#include <cctype>
 #include <charconv>
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 using json = nlohmann::json;
 
+namespace {
+std::optional<size_t> parseSize(const std::string &value) {
+  size_t size;
+  auto [ptr, err] =
+      std::from_chars(value.data(), value.data() + value.size(), size);
+  if (err != std::errc() || ptr != value.data() + value.size()) {
+    return std::nullopt;
+  }
+  return size;
+}
+size_t defaultThreads() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+} // namespace
+
 TaskManager::TaskManager(const std::string &filePath)
-    : tasks_(), nextId_(1), filePath_(filePath) {
+    : tasks_(), nextId_(1), filePath_(filePath),
+      history_(1000, size_t{64} << 20), redo_(1000, size_t{64} << 20),
+      foldCache_(true),
+      colorMode_(ColorMode::automatic), pageSize_(50),
+      threads_(defaultThreads()), parallelThreshold_(100000), version_(0),
+      queryCache_(8), trace_(nullptr), prefixIndexReady_(false) {
   printError(load());
 }
 CustomError TaskManager::executeCommand(std::unique_ptr<Command> command) {
-  CustomError e = command->execute();
+  return runCommand(AnyCommand(std::move(command)));
+}
+CustomError TaskManager::runCommand(AnyCommand &&command) {
+  CustomError e =
+      visitCommand(command, [](auto &held) { return held.execute(); });
   if (e != CustomError::Ok) {
     return e;
   }
-  stack_.push(std::move(command));
+  redo_.clear();
+  if (!history_.push(std::move(command)) && history_.depth() > 0) {
+    std::cout << "Note: too large for the undo history, cannot be undone\n";
+  }
   return CustomError::Ok;
 }
 void TaskManager::undo() {
-  if (stack_.empty()) {
-    std::cout << "Nothing to do\n";
+  std::optional<AnyCommand> command = history_.pop();
+  if (!command) {
+    std::cout << "Nothing to do";
+    if (history_.evicted() > 0) {
+      std::cout << " (" << history_.evicted()
+                << " older commands were dropped from the undo history)";
+    }
+    std::cout << '\n';
     return;
   }
-  stack_.top()->undo();
-  stack_.pop();
+  if (visitCommand(*command, [](auto &held) { return held.undo(); }) ==
+      CustomError::Ok) {
+    redo_.push(std::move(*command));
+  }
+}
+void TaskManager::redo() {
+  std::optional<AnyCommand> command = redo_.pop();
+  if (!command) {
+    std::cout << "Nothing to redo\n";
+    return;
+  }
+  if (visitCommand(*command, [](auto &held) { return held.redo(); }) ==
+      CustomError::Ok) {
+    history_.push(std::move(*command));
+  }
 }
 
 TaskManager::~TaskManager() = default;
@@ -69,25 +118,23 @@ std::optional<uint64_t> TaskManager::add(const std::string &text) {
         priority = Priority::low;
       }
       std::string txt = text.substr(delimCat + 1, text.size());
-      tasks_.push_back(Task(nextId_, txt, category, priority));
+      appendTask(Task(nextId_, txt, category, priority, false, &editPool_));
     } else {
-      tasks_.push_back(Task(nextId_, text, category));
+      appendTask(
+          Task(nextId_, text, category, Priority::low, false, &editPool_));
     }
   } else {
-    tasks_.push_back(Task(nextId_, taskText));
+    appendTask(
+        Task(nextId_, taskText, "general", Priority::low, false, &editPool_));
   }
   return nextId_++;
 }
-std::pair<std::optional<size_t>, std::optional<std::string>>
-TaskManager::editTask(const std::string &text, size_t idx) {
+std::pair<std::optional<uint64_t>, std::optional<std::string>>
+TaskManager::editTask(const std::string &text) {
   std::string taskText;
   std::string previousText;
   std::string taskId;
   std::string flag;
-  if (idx != std::string::npos) {
-    tasks_[idx].changeText(text);
-    return {{idx}, {text}};
-  }
   if (text.empty()) {
     std::cout << "Enter task name: ";
     std::getline(std::cin, taskText);
@@ -114,124 +161,67 @@ TaskManager::editTask(const std::string &text, size_t idx) {
     return {{}, {}};
   }
   previousText = tasks_[*index].getText();
-  tasks_[*index].changeText(flag);
-  return {index, previousText};
+  setTaskText(*index, flag);
+  return {rid.id, previousText};
+}
+std::optional<std::string> TaskManager::replaceTaskText(uint64_t id,
+                                                        std::string_view text) {
+  std::optional<size_t> index = findIndexById(id);
+  if (!index) {
+    return std::nullopt;
+  }
+  std::string previousText(tasks_[*index].getText());
+  setTaskText(*index, std::string(text));
+  return previousText;
+}
+std::optional<bool> TaskManager::setTaskDoneById(uint64_t id, bool done) {
+  std::optional<size_t> index = findIndexById(id);
+  if (!index) {
+    return std::nullopt;
+  }
+  const bool previous = tasks_[*index].isDone();
+  setTaskDoneAt(*index, done);
+  return previous;
+}
+std::optional<std::pair<Task, size_t>> TaskManager::takeTask(uint64_t id) {
+  std::optional<size_t> index = findIndexById(id);
+  if (!index) {
+    return std::nullopt;
+  }
+  Task task = tasks_[*index];
+  eraseTask(*index);
+  return std::pair{std::move(task), *index};
 }
 std::optional<uint64_t> TaskManager::insertByIndex(const Task &task,
                                                    size_t index) {
   if (index <= tasks_.size()) {
-    tasks_.insert(tasks_.begin() + index, task);
+    insertTask(index, task);
     return task.getId();
   }
   return {};
 }
 std::vector<Task> TaskManager::clearTasks() {
-  std::vector<Task> tasksCopy = std::move(tasks_);
+  // Copy rather than move: the copies own heap storage, which lets the arena
+  // and pool be dropped wholesale.
+  std::vector<Task> tasksCopy(tasks_.begin(), tasks_.end());
+  tasks_.clear();
+  tasks_.shrink_to_fit();
+  releaseTextStorage();
+  rebuildIndexes();
   return tasksCopy;
 }
 void TaskManager::loadTasks(std::vector<Task> &tasks) {
   tasks_ = std::move(tasks);
+  rebuildIndexes();
 }
 std::optional<uint64_t> TaskManager::removeById(uint64_t id) {
   std::optional<size_t> index = findIndexById(id);
   if (index) {
-    tasks_.erase(tasks_.begin() + *index);
+    eraseTask(*index);
     return id;
   }
   return {};
 }
-void TaskManager::ls(const std::string &flag) const {
-  if (tasks_.empty()) {
-    std::cout << "Todo List is empty!\n";
-    return;
-  }
-
-  std::vector<Task> tasksToShow;
-
-  if (flag == "-d" || flag == "--done") {
-    std::copy_if(tasks_.begin(), tasks_.end(), std::back_inserter(tasksToShow),
-                 [](const Task &task) { return task.isDone(); });
-  } else if (flag == "-p" || flag == "--pending") {
-    std::copy_if(tasks_.begin(), tasks_.end(), std::back_inserter(tasksToShow),
-                 [](const Task &task) { return !task.isDone(); });
-  } else if (flag == "-l" || flag == "--low") {
-    std::copy_if(
-        tasks_.begin(), tasks_.end(), std::back_inserter(tasksToShow),
-        [](const Task &task) { return task.getPriority() == Priority::low; });
-  } else if (flag == "-m" || flag == "--medium") {
-    std::copy_if(tasks_.begin(), tasks_.end(), std::back_inserter(tasksToShow),
-                 [](const Task &task) {
-                   return task.getPriority() == Priority::medium;
-                 });
-  } else if (flag == "-h" || flag == "--high") {
-    std::copy_if(
-        tasks_.begin(), tasks_.end(), std::back_inserter(tasksToShow),
-        [](const Task &task) { return task.getPriority() == Priority::high; });
-  } else {
-    tasksToShow = tasks_;
-  }
-
-  if (flag.find("-s") != std::string::npos ||
-      flag.find("--sort") != std::string::npos) {
-    if (flag.find("id") != std::string::npos) {
-      std::sort(
-          tasksToShow.begin(), tasksToShow.end(),
-          [](const Task &i, const Task &j) { return i.getId() < j.getId(); });
-    } else if (flag.find("done") != std::string::npos) {
-      std::sort(
-          tasksToShow.begin(), tasksToShow.end(),
-          [](const Task &i, const Task &j) { return i.isDone() > j.isDone(); });
-    } else if (flag.find("priority") != std::string::npos) {
-      std::sort(tasksToShow.begin(), tasksToShow.end(),
-                [](const Task &i, const Task &j) {
-                  return i.getPriority() < j.getPriority();
-                });
-    }
-  }
-
-  std::vector<Task> foundTasks;
-  if (flag.find("-f") != std::string::npos ||
-      flag.find("--find") != std::string::npos) {
-    size_t delimiter = flag.find(" ");
-    if (delimiter != std::string::npos) {
-      std::string textToSearch = flag.substr(delimiter + 1);
-      std::copy_if(tasksToShow.begin(), tasksToShow.end(),
-                   std::back_inserter(foundTasks),
-                   [&textToSearch](const Task &task) {
-                     return stringToLower(task.getText()).find(textToSearch) !=
-                            std::string::npos;
-                   });
-      tasksToShow = foundTasks;
-    }
-  }
-
-  int i = 1;
-
-  for (const auto &task : tasksToShow) {
-    std::cout << i++ << " [id=" << task.getId() << "]" << " ["
-              << task.getCategory() << "] " << "[";
-    std::string color;
-    Priority priority = task.getPriority();
-    switch (priority) {
-    case Priority::low:
-      color = "32";
-      break;
-    case Priority::medium:
-      color = "33";
-      break;
-    case Priority::high:
-      color = "31";
-      break;
-    }
-    {
-      Color colorText(std::cout, color);
-      std::cout << task.getPriorityString();
-    }
-
-    std::cout << "] " << (task.isDone() ? " 🗹 " : " ☐ ");
-    std::cout << task.getText() << std::endl;
-  }
-};
 CustomError TaskManager::save(const std::string &path) const {
   json root;
   root["next_id"] = nextId_;
@@ -245,6 +235,10 @@ CustomError TaskManager::save(const std::string &path) const {
     t["done"] = task.isDone();
     root["tasks"].push_back(t);
   }
+  root["views"] = json::object();
+  for (const auto &[name, view] : savedViews_) {
+    root["views"][name] = view.options;
+  }
   std::ofstream file(path);
   if (!file) {
     return CustomError::IoError;
@@ -265,7 +259,7 @@ CustomError TaskManager::remove(const std::string &flag) {
   if (!index) {
     return CustomError::NoSuchTask;
   }
-  tasks_.erase(tasks_.begin() + *index);
+  eraseTask(*index);
   return CustomError::Ok;
 }
 std::pair<std::optional<Task>, std::optional<size_t>>
@@ -274,17 +268,14 @@ TaskManager::removeTask(const std::string &flag) {
   if (rid.code != CustomError::Ok) {
     return {};
   }
-  std::optional<uint64_t> index = findIndexById(*rid.id);
-
-  if (!index) {
+  auto taken = takeTask(*rid.id);
+  if (!taken) {
     return {};
   }
-  Task taskToReturn = tasks_[*index];
-  tasks_.erase(tasks_.begin() + *index);
-  return {taskToReturn, index};
+  return {std::move(taken->first), taken->second};
 }
 CustomError TaskManager::markDone(const std::string &flag) {
-  ResolvedId rid = resolveIdFromUserNumber(flag);
+  ResolvedId rid = resolveIdFromUserNumber(flag, true);
   if (rid.code != CustomError::Ok) {
     return rid.code;
   }
@@ -293,11 +284,11 @@ CustomError TaskManager::markDone(const std::string &flag) {
   if (!index) {
     return CustomError::NoSuchTask;
   }
-  tasks_[*index].markAsDone(true);
+  setTaskDoneAt(*index, true);
   return CustomError::Ok;
 }
 CustomError TaskManager::undone(const std::string &flag) {
-  ResolvedId rid = resolveIdFromUserNumber(flag);
+  ResolvedId rid = resolveIdFromUserNumber(flag, true);
   if (rid.code != CustomError::Ok) {
     return rid.code;
   }
@@ -306,12 +297,12 @@ CustomError TaskManager::undone(const std::string &flag) {
   if (!index) {
     return CustomError::NoSuchTask;
   }
-  tasks_[*index].markAsDone(false);
+  setTaskDoneAt(*index, false);
   return CustomError::Ok;
 }
 std::optional<bool>
 TaskManager::getTaskDoneStatus(const std::string &flag) const {
-  ResolvedId rid = resolveIdFromUserNumber(flag);
+  ResolvedId rid = resolveIdFromUserNumber(flag, true);
   if (rid.code != CustomError::Ok) {
     return {};
   }
@@ -323,7 +314,7 @@ TaskManager::getTaskDoneStatus(const std::string &flag) const {
   return tasks_[*index].isDone();
 }
 CustomError TaskManager::setTaskDone(const std::string &flag, bool done) {
-  ResolvedId rid = resolveIdFromUserNumber(flag);
+  ResolvedId rid = resolveIdFromUserNumber(flag, true);
   if (rid.code != CustomError::Ok) {
     return rid.code;
   }
@@ -332,7 +323,7 @@ CustomError TaskManager::setTaskDone(const std::string &flag, bool done) {
   if (!index) {
     return CustomError::NoSuchTask;
   }
-  tasks_[*index].markAsDone(done);
+  setTaskDoneAt(*index, done);
   return CustomError::Ok;
 }
 void TaskManager::printHelp() const {
@@ -350,13 +341,63 @@ edit <id> <new_text>
     Change text of task
 
 ls [options]
-    -s, --sort <id|done|priority>   Sort tasks
+    -s, --sort <key>                Sort by id, done, priority, text or
+                                    category
     -f, --find <text>               Search tasks by text
     -p, --pending                   Show only pending tasks
     -d, --done                      Show only completed tasks
     -l, --low                       Show only low priority tasks
     -m, --medium                    Show only medium priority tasks
     -h, --high                      Show only high priority tasks
+    -c, --category <name>           Show only tasks in a category
+    --fuzzy <text>                  Search allowing typos, closest first
+    --regex <pattern>               Search with a regular expression
+    --limit <n>                     Show at most n tasks
+    --offset <n>                    Skip the first n matching tasks
+    --count                         Print the number of matching tasks
+    --plain                         No colors, even on a terminal
+    --format <human|jsonl>          jsonl prints one JSON object per task
+    --pager                         Show one page at a time
+    --group category                List tasks under a header per category
+    --explain                       Also print the plan, with time and
+                                    rows per stage, to stderr
+    Options can be combined, e.g. ls -p -h -s id
+
+stats
+    Task counts per category: total, done, pending, and pending by
+    priority
+
+view save <name> <ls options>
+    Save ls options under a name, e.g. view save urgent -p -h
+
+view <name>
+    List the tasks of a saved view
+
+view list
+    Show saved views and how many tasks each has
+
+view del <name>
+    Delete a saved view
+
+set <option> <value>
+    fold-cache <on|off>             Keep lowercased task text for --find
+                                    (faster search, roughly doubles text
+                                    memory)
+    color <auto|on|off>             Color priorities; auto only when
+                                    output is a terminal
+    page-size <n>                   Rows per page for ls --pager
+    query-cache <n>                 Remember the last n ls results until
+                                    the next change (0 turns it off)
+    threads <n>                     Threads for filtering large lists
+                                    (0 uses every core, at most
+                                    4 per core)
+    parallel-threshold <n>          Filter on several threads from n
+                                    candidate tasks up
+    undo-depth <n>                  Commands kept for undo, and for redo
+                                    (0 turns undo off)
+    undo-memory <KiB>               Memory the undo and the redo history
+                                    may each use; oldest commands are
+                                    dropped first
 
 done <id>
     Mark task as done
@@ -364,12 +405,22 @@ done <id>
 undone <id>
     Mark task as not done
 
+    done and undone also take the start of words in a task's text
+    instead of its number, e.g. done buy mi
+
 del <id>
     Delete task
 
+find-prefix <text>
+    Show tasks with words starting with each word of text
+
 undo
     Undo previous command
 
+redo
+    Redo the last undone command; any new command discards what is left
+    to redo
+
 clear
     Clear all tasks
 
@@ -381,6 +432,8 @@ CustomError TaskManager::load() {
   std::ifstream file(filePath_);
   json data;
   tasks_.clear();
+  savedViews_.clear();
+  releaseTextStorage();
   uint64_t max = 0;
 
   if (!file) {
@@ -389,30 +442,271 @@ CustomError TaskManager::load() {
   try {
     file >> data;
     data.at("next_id").get_to(nextId_);
-    for (const auto &task : data.at("tasks")) {
+    const json &items = data.at("tasks");
+    tasks_.reserve(items.size());
+    for (const auto &task : items) {
       uint64_t id = task.at("id").get<uint64_t>();
       max = std::max(max, id);
-      const std::string text = task.at("text").get<const std::string>();
-      const std::string category = task.at("category").get<const std::string>();
+      const std::string &text = task.at("text").get_ref<const std::string &>();
+      const std::string &category =
+          task.at("category").get_ref<const std::string &>();
       const Priority priority = task.at("priority").get<const Priority>();
       bool done = task.at("done").get<bool>();
-      tasks_.push_back(Task(id, text, category, priority, done));
+      tasks_.push_back(
+          Task(id, text, category, priority, done, &textArena_));
+    }
+    // Saved views are optional so files from older versions still load.
+    if (auto views = data.find("views"); views != data.end()) {
+      for (const auto &[name, options] : views->items()) {
+        std::optional<SavedView> view =
+            compileView(options.get_ref<const std::string &>());
+        if (!view) {
+          throw std::runtime_error("bad view");
+        }
+        savedViews_[name] = std::move(*view);
+      }
     }
   } catch (const std::exception &e) {
+    rebuildIndexes();
     return CustomError::ParseError;
   }
+  rebuildIndexes();
   nextId_ = std::max(nextId_, max + 1);
   return CustomError::Ok;
 }
+CustomError TaskManager::setOption(const std::string &flag) {
+  auto split = flag.find(' ');
+  if (split == std::string::npos) {
+    return CustomError::ParseError;
+  }
+  std::string name = trim(flag.substr(0, split));
+  std::string value = trim(flag.substr(split + 1));
+  if (name == "fold-cache") {
+    if (value != "on" && value != "off") {
+      return CustomError::ParseError;
+    }
+    setFoldCache(value == "on");
+    return CustomError::Ok;
+  }
+  if (name == "page-size") {
+    std::optional<size_t> size = parseSize(value);
+    if (!size || *size == 0) {
+      return CustomError::ParseError;
+    }
+    pageSize_ = *size;
+    return CustomError::Ok;
+  }
+  if (name == "query-cache") {
+    std::optional<size_t> entries = parseSize(value);
+    if (!entries) {
+      return CustomError::ParseError;
+    }
+    queryCache_.setCapacity(*entries);
+    return CustomError::Ok;
+  }
+  if (name == "threads") {
+    std::optional<size_t> threads = parseSize(value);
+    if (!threads) {
+      return CustomError::ParseError;
+    }
+    // More threads than a few per core only adds start-up cost.
+    threads_ = *threads == 0 ? defaultThreads()
+                             : std::min(*threads, 4 * defaultThreads());
+    return CustomError::Ok;
+  }
+  if (name == "parallel-threshold") {
+    std::optional<size_t> rows = parseSize(value);
+    if (!rows) {
+      return CustomError::ParseError;
+    }
+    parallelThreshold_ = *rows;
+    return CustomError::Ok;
+  }
+  if (name == "undo-depth" || name == "undo-memory") {
+    std::optional<size_t> limit = parseSize(value);
+    if (!limit) {
+      return CustomError::ParseError;
+    }
+    const size_t before = history_.evicted();
+    const size_t depth = name == "undo-depth" ? *limit : history_.depth();
+    const size_t budget =
+        name == "undo-memory"
+            ? std::min(*limit, std::numeric_limits<size_t>::max() >> 10) << 10
+            : history_.budget();
+    history_.setLimits(depth, budget);
+    redo_.setLimits(depth, budget);
+    if (history_.evicted() > before) {
+      std::cout << "Dropped " << history_.evicted() - before
+                << " oldest undo entries\n";
+    }
+    return CustomError::Ok;
+  }
+  if (name == "color") {
+    if (value == "auto") {
+      colorMode_ = ColorMode::automatic;
+    } else if (value == "on") {
+      colorMode_ = ColorMode::always;
+    } else if (value == "off") {
+      colorMode_ = ColorMode::never;
+    } else {
+      return CustomError::ParseError;
+    }
+    return CustomError::Ok;
+  }
+  return CustomError::ParseError;
+}
+void TaskManager::setFoldCache(bool enabled) {
+  foldCache_ = enabled;
+  foldedText_.clear();
+  foldedText_.shrink_to_fit();
+  if (foldCache_) {
+    foldedText_.reserve(tasks_.size());
+    for (const auto &task : tasks_) {
+      foldedText_.push_back(stringToLower(task.getText()));
+    }
+  }
+}
+const std::string &TaskManager::foldedText(size_t index,
+                                           std::string &scratch) const {
+  if (foldCache_) {
+    return foldedText_[index];
+  }
+  scratch = stringToLower(tasks_[index].getText());
+  return scratch;
+}
+void TaskManager::renumberRows(size_t from) {
+  for (size_t row = from; row < columns_.size(); ++row) {
+    rowById_[columns_.id(row)] = row;
+  }
+}
+void TaskManager::appendTask(Task task) {
+  ++version_;
+  rowById_[task.getId()] = tasks_.size();
+  doneBits_.push(task.isDone());
+  pendingBits_.push(!task.isDone());
+  for (size_t p = 0; p < priorityBits_.size(); ++p) {
+    priorityBits_[p].push(static_cast<size_t>(task.getPriority()) == p);
+  }
+  if (foldCache_) {
+    foldedText_.push_back(stringToLower(task.getText()));
+  }
+  categoryStats_.add(task.getCategoryId(), task.getFlags());
+  if (prefixIndexReady_) {
+    prefixIndex_.add(task.getId(), stringToLower(task.getText()));
+  }
+  columns_.push(task);
+  tasks_.push_back(std::move(task));
+  refreshSavedViews(tasks_.size() - 1);
+}
+void TaskManager::insertTask(size_t index, const Task &task) {
+  ++version_;
+  doneBits_.insert(index, task.isDone());
+  pendingBits_.insert(index, !task.isDone());
+  for (size_t p = 0; p < priorityBits_.size(); ++p) {
+    priorityBits_[p].insert(index,
+                            static_cast<size_t>(task.getPriority()) == p);
+  }
+  if (foldCache_) {
+    foldedText_.insert(foldedText_.begin() + index,
+                       stringToLower(task.getText()));
+  }
+  categoryStats_.add(task.getCategoryId(), task.getFlags());
+  if (prefixIndexReady_) {
+    prefixIndex_.add(task.getId(), stringToLower(task.getText()));
+  }
+  columns_.insert(index, task);
+  tasks_.insert(tasks_.begin() + index, task);
+  renumberRows(index);
+  refreshSavedViews(index);
+}
+void TaskManager::eraseTask(size_t index) {
+  ++version_;
+  dropFromSavedViews(columns_.id(index));
+  rowById_.erase(columns_.id(index));
+  categoryStats_.remove(columns_.category(index), columns_.flags(index));
+  if (prefixIndexReady_) {
+    prefixIndex_.remove(columns_.id(index),
+                        stringToLower(tasks_[index].getText()));
+  }
+  doneBits_.erase(index);
+  pendingBits_.erase(index);
+  for (auto &bits : priorityBits_) {
+    bits.erase(index);
+  }
+  if (foldCache_) {
+    foldedText_.erase(foldedText_.begin() + index);
+  }
+  columns_.erase(index);
+  tasks_.erase(tasks_.begin() + index);
+  renumberRows(index);
+}
+void TaskManager::setTaskText(size_t index, const std::string &text) {
+  ++version_;
+  if (prefixIndexReady_) {
+    prefixIndex_.remove(columns_.id(index),
+                        stringToLower(tasks_[index].getText()));
+    prefixIndex_.add(columns_.id(index), stringToLower(text));
+  }
+  tasks_[index].changeText(text, &editPool_);
+  columns_.setText(index, text);
+  if (foldCache_) {
+    foldedText_[index] = stringToLower(text);
+  }
+  refreshSavedViews(index);
+}
+void TaskManager::setTaskDoneAt(size_t index, bool done) {
+  ++version_;
+  categoryStats_.remove(columns_.category(index), columns_.flags(index));
+  categoryStats_.add(columns_.category(index),
+                     TaskColumns::pack(columns_.priority(index), done));
+  tasks_[index].markAsDone(done);
+  columns_.setDone(index, done);
+  doneBits_.set(index, done);
+  pendingBits_.set(index, !done);
+  refreshSavedViews(index);
+}
+void TaskManager::releaseTextStorage() {
+  textArena_.release();
+  editPool_.release();
+}
+void TaskManager::rebuildIndexes() {
+  ++version_;
+  columns_.assign(tasks_);
+  rowById_.clear();
+  categoryStats_.clear();
+  for (const auto &task : tasks_) {
+    categoryStats_.add(task.getCategoryId(), task.getFlags());
+  }
+  renumberRows(0);
+  doneBits_.clear();
+  pendingBits_.clear();
+  for (auto &bits : priorityBits_) {
+    bits.clear();
+  }
+  for (const auto &task : tasks_) {
+    doneBits_.push(task.isDone());
+    pendingBits_.push(!task.isDone());
+    for (size_t p = 0; p < priorityBits_.size(); ++p) {
+      priorityBits_[p].push(static_cast<size_t>(task.getPriority()) == p);
+    }
+  }
+  setFoldCache(foldCache_);
+  // Rebuilt on the next lookup.
+  prefixIndex_.clear();
+  prefixIndexReady_ = false;
+  for (auto &[name, view] : savedViews_) {
+    rebuildSavedView(view);
+  }
+}
 std::optional<size_t> TaskManager::findIndexById(uint64_t id) const {
-  auto it = std::find_if(tasks_.begin(), tasks_.end(),
-                         [id](const Task &task) { return task.getId() == id; });
-  if (it == tasks_.end()) {
+  auto it = rowById_.find(id);
+  if (it == rowById_.end()) {
     return std::nullopt;
   }
-  return std::distance(tasks_.begin(), it);
+  return it->second;
 }
-ResolvedId TaskManager::resolveIdFromUserNumber(const std::string &flag) const {
+ResolvedId TaskManager::resolveIdFromUserNumber(const std::string &flag,
+                                                bool byText) const {
   std::string input = flag;
   if (flag.empty()) {
     std::cout << "Enter task number: ";
@@ -421,10 +715,21 @@ ResolvedId TaskManager::resolveIdFromUserNumber(const std::string &flag) const {
   input = trim(input);
 
   ResultIndex index = parseIndex(input);
+  if (byText && index.code == CustomError::InvalidNumber && !input.empty() &&
+      !std::isdigit(static_cast<unsigned char>(input[0])) &&
+      input[0] != '-' && input[0] != '+') {
+    const std::vector<size_t> numbers = completeTaskNumber(input);
+    if (numbers.size() == 1) {
+      return {CustomError::Ok, columns_.id(numbers[0] - 1)};
+    }
+    return {numbers.empty() ? CustomError::NoSuchTask
+                            : CustomError::AmbiguousTask,
+            std::nullopt};
+  }
   if (index.code != CustomError::Ok) {
     return {index.code, std::nullopt};
   }
-  return {CustomError::Ok, tasks_[index.index].getId()};
+  return {CustomError::Ok, columns_.id(index.index)};
 }
 ResultIndex TaskManager::parseIndex(const std::string &userInput) const {
   ResultIndex index;
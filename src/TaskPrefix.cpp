@@ -0,0 +1,72 @@
+#include "../include/PrefixIndex.hpp"
+#include "../include/Query.hpp"
+#include "../include/TaskManager.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+// Distinct rows of the tasks in range, sorted.
+template <typename RowOf>
+std::vector<size_t> rowsIn(const PrefixIndex::Range &range, RowOf rowOf) {
+  std::vector<size_t> rows;
+  for (auto it = range.begin; it != range.end; ++it) {
+    rows.push_back(rowOf(it->second));
+  }
+  std::ranges::sort(rows);
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+  return rows;
+}
+} // namespace
+
+const PrefixIndex &TaskManager::prefixIndex() const {
+  if (!prefixIndexReady_) {
+    std::string scratch;
+    for (size_t row = 0; row < tasks_.size(); ++row) {
+      prefixIndex_.add(columns_.id(row), foldedText(row, scratch));
+    }
+    prefixIndexReady_ = true;
+  }
+  return prefixIndex_;
+}
+std::vector<size_t>
+TaskManager::rowsWithPrefixes(const std::string &text) const {
+  const std::string folded = stringToLower(text);
+  const std::vector<std::string_view> words = indexWords(folded);
+  auto rowOf = [this](uint64_t id) { return rowById_.find(id)->second; };
+
+  std::vector<size_t> rows;
+  for (size_t i = 0; i < words.size(); ++i) {
+    std::vector<size_t> matching = rowsIn(prefixIndex().find(words[i]), rowOf);
+    if (i == 0) {
+      rows = std::move(matching);
+      continue;
+    }
+    std::vector<size_t> both;
+    std::ranges::set_intersection(rows, matching, std::back_inserter(both));
+    rows = std::move(both);
+  }
+  return rows;
+}
+void TaskManager::findPrefix(const std::string &flag) const {
+  if (tasks_.empty()) {
+    std::cout << "Todo List is empty!\n";
+    return;
+  }
+  if (indexWords(stringToLower(flag)).empty()) {
+    printError(CustomError::ParseError);
+    return;
+  }
+  renderRows(rowsWithPrefixes(flag), LsQuery(), 1);
+}
+std::vector<size_t>
+TaskManager::completeTaskNumber(const std::string &typed) const {
+  std::vector<size_t> rows = rowsWithPrefixes(typed);
+  for (size_t &row : rows) {
+    ++row;
+  }
+  return rows;
+}
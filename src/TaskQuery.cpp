@@ -0,0 +1,613 @@
+#include "../include/Color.hpp"
+#include "../include/Fuzzy.hpp"
+#include "../include/Output.hpp"
+#include "../include/Parallel.hpp"
+#include "../include/Query.hpp"
+#include "../include/QueryTrace.hpp"
+#include "../include/RowSort.hpp"
+#include "../include/TaskManager.hpp"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+// Everything between a row's category and its text depends only on the
+// task's flags byte, so each combination is rendered once up front.
+std::array<std::string, 8> buildRowTemplates(bool color) {
+  std::array<std::string, 8> templates;
+  for (Priority priority : {Priority::low, Priority::medium, Priority::high}) {
+    for (bool done : {false, true}) {
+      std::ostringstream row;
+      row << "] [";
+      if (color) {
+        const char *code = priority == Priority::high     ? "31"
+                           : priority == Priority::medium ? "33"
+                                                          : "32";
+        Color colorText(row, code);
+        row << priorityName(priority);
+      } else {
+        row << priorityName(priority);
+      }
+      row << "] " << (done ? " 🗹 " : " ☐ ");
+      templates[Task::pack(priority, done)] = row.str();
+    }
+  }
+  return templates;
+}
+const std::array<std::string, 8> &rowTemplates(bool color) {
+  static const std::array<std::string, 8> colored = buildRowTemplates(true);
+  static const std::array<std::string, 8> plain = buildRowTemplates(false);
+  return color ? colored : plain;
+}
+// Text filters a row scan applies, for ls --explain.
+std::string textFilters(const LsQuery &query) {
+  std::string filters;
+  auto add = [&filters](const char *name) {
+    filters += filters.empty() ? name : std::string(", ") + name;
+  };
+  if (query.category) {
+    add("category");
+  }
+  if (!query.find.empty()) {
+    add("--find");
+  }
+  if (query.regex) {
+    add(query.regex->literals().empty() ? "--regex"
+                                        : "--regex with literal prefilter");
+  }
+  return filters.empty() ? "no text filter" : filters;
+}
+// offset + limit, saturating: the rows a bounded ls needs to look at.
+size_t windowEnd(const LsQuery &query) {
+  const size_t limit = query.limit.value_or(0);
+  return query.offset > std::numeric_limits<size_t>::max() - limit
+             ? std::numeric_limits<size_t>::max()
+             : query.offset + limit;
+}
+} // namespace
+
+void TaskManager::ls(const std::string &flag) const {
+  const QueryTrace::Clock::time_point started = QueryTrace::Clock::now();
+  std::optional<LsQuery> query = parseLsQuery(flag);
+  if (!query) {
+    printError(CustomError::ParseError);
+    return;
+  }
+  if (!query->explain) {
+    runLs(*query);
+    return;
+  }
+
+  // The query runs and prints as usual; the stages below record into the
+  // trace while trace_ points at it.
+  QueryTrace trace(started);
+  trace.stage("parse", "ls options", std::nullopt);
+  trace_ = &trace;
+  runLs(*query);
+  trace_ = nullptr;
+  // stderr, so the plan never mixes into output meant for a pipe.
+  std::cout << std::flush;
+  trace.print(std::cerr);
+  std::cerr << std::flush;
+}
+void TaskManager::runLs(const LsQuery &query) const {
+  if (query.count && query.find.empty() && query.fuzzy.empty() &&
+      !query.regex && !query.category) {
+    if (query.group == GroupKey::category) {
+      // Straight from the per-category counters; no task is visited.
+      std::vector<uint32_t> perCategory(categoryStats_.size());
+      for (size_t id = 0; id < perCategory.size(); ++id) {
+        const CategoryStats::Counts &counts =
+            categoryStats_.counts(static_cast<CategoryId>(id));
+        for (uint8_t flags = 0; flags < counts.size(); ++flags) {
+          if (flagsMatch(query, flags)) {
+            perCategory[id] += counts[flags];
+          }
+        }
+      }
+      if (trace_) {
+        trace_->stage("count", "per-category counters, no rows visited",
+                      std::reduce(perCategory.begin(), perCategory.end(),
+                                  size_t{0}));
+      }
+      printGroupCounts(perCategory);
+      return;
+    }
+    const size_t count = selectByFlags(query).count();
+    if (trace_) {
+      trace_->stage("count", "popcount of the flag bitmaps", count);
+    }
+    std::cout << count << std::endl;
+    return;
+  }
+
+  if (tasks_.empty() && !query.count) {
+    // jsonl lists nothing rather than a message a parser would choke on.
+    if (query.format == OutputFormat::human) {
+      std::cout << "Todo List is empty!\n";
+    }
+    return;
+  }
+
+  if (query.pager && !query.count) {
+    pageRows(query);
+    return;
+  }
+
+  std::vector<size_t> rows = findRows(query);
+  if (query.count && query.group == GroupKey::category) {
+    std::vector<uint32_t> perCategory(CategoryTable::shared().size());
+    for (size_t row : rows) {
+      ++perCategory[columns_.category(row)];
+    }
+    if (trace_) {
+      trace_->stage("count", "tally rows per category id", rows.size());
+    }
+    printGroupCounts(perCategory);
+    return;
+  }
+  if (query.count) {
+    std::cout << rows.size() << std::endl;
+    return;
+  }
+  renderRows(rows, query, 1);
+  if (trace_) {
+    std::string format =
+        query.format == OutputFormat::jsonl ? "jsonl" : "human";
+    if (query.group == GroupKey::category) {
+      format += ", grouped by category";
+    }
+    trace_->stage("render", format, rows.size());
+  }
+}
+void TaskManager::renderRows(std::span<const size_t> rows, const LsQuery &query,
+                             size_t firstNumber) const {
+  if (query.group == GroupKey::category) {
+    renderGroups(rows, query, firstNumber);
+  } else if (query.format == OutputFormat::jsonl) {
+    printJsonRows(rows);
+  } else {
+    printRows(rows, useColor(query), firstNumber);
+  }
+}
+std::vector<size_t> TaskManager::findRows(const LsQuery &query) const {
+  const std::string key = normalizedKey(query);
+  if (const std::vector<size_t> *rows = queryCache_.find(key, version_)) {
+    if (trace_) {
+      trace_->stage("cache", "hit, result reused", rows->size());
+    }
+    return *rows;
+  }
+  const Bitmap selected = selectByFlags(query);
+  if (trace_) {
+    trace_->stage("select",
+                  query.done || query.priorities
+                      ? "AND/OR of done and priority bitmaps"
+                      : "all rows, no flag filter",
+                  selected.count());
+  }
+  std::vector<size_t> rows = queryRows(query, selected);
+  queryCache_.insert(key, version_, rows);
+  return rows;
+}
+void TaskManager::pageRows(const LsQuery &query) const {
+  // The first screen comes from a bounded query for one row more than a
+  // page, so the prompt only shows when there is more. Bounded queries list
+  // a prefix of the full ordering; later pages are slices of the full row
+  // list, built only if the user asks for more.
+  const size_t probe = std::max(pageSize_, pageSize_ + 1);
+  LsQuery firstQuery = query;
+  firstQuery.limit = std::min(query.limit.value_or(probe), probe);
+  std::vector<size_t> rows = findRows(firstQuery);
+  size_t shown = std::min(pageSize_, rows.size());
+  renderRows(std::span<const size_t>(rows).first(shown), query, 1);
+
+  bool haveAll = false;
+  while (shown < rows.size()) {
+    if (haveAll) {
+      std::cout << "-- " << shown << " of " << rows.size()
+                << ", Enter for more, q to stop --" << std::endl;
+    } else {
+      std::cout << "-- Enter for more, q to stop --" << std::endl;
+    }
+    std::string answer;
+    if (!std::getline(std::cin, answer) || trim(answer) == "q") {
+      return;
+    }
+    if (!haveAll) {
+      rows = findRows(query);
+      haveAll = true;
+    }
+    const size_t count = std::min(pageSize_, rows.size() - shown);
+    renderRows(std::span<const size_t>(rows).subspan(shown, count), query,
+               shown + 1);
+    shown += count;
+  }
+}
+bool TaskManager::useColor(const LsQuery &query) const {
+  if (query.plain) {
+    return false;
+  }
+  switch (colorMode_) {
+  case ColorMode::always:
+    return true;
+  case ColorMode::never:
+    return false;
+  case ColorMode::automatic:
+    break;
+  }
+  return stdoutIsTerminal();
+}
+Bitmap TaskManager::selectByFlags(const LsQuery &query) const {
+  // Priorities are OR-ed together, then intersected with the done/pending
+  // set, a word at a time.
+  Bitmap selected(tasks_.size(), true);
+  if (query.priorities != 0) {
+    Bitmap anyPriority(tasks_.size(), false);
+    for (size_t p = 0; p < priorityBits_.size(); ++p) {
+      if (query.priorities & (1u << p)) {
+        anyPriority |= priorityBits_[p];
+      }
+    }
+    selected &= anyPriority;
+  }
+  if (query.done) {
+    selected &= *query.done ? doneBits_ : pendingBits_;
+  }
+  return selected;
+}
+std::vector<size_t> TaskManager::queryRows(const LsQuery &query,
+                                           const Bitmap &selected) const {
+  std::vector<size_t> rows;
+
+  // One dictionary lookup per query, then integer compares per row.
+  std::optional<CategoryId> category;
+  if (query.category) {
+    category = CategoryTable::shared().find(*query.category);
+    if (!category) {
+      if (trace_) {
+        trace_->stage("filter", "unknown category, nothing scanned", 0);
+      }
+      return rows;
+    }
+  }
+  if (!query.fuzzy.empty()) {
+    return fuzzyRows(query, selected, category);
+  }
+  std::string scratch;
+  auto rowMatches = [&](size_t row) {
+    return matchesText(query, category, row, scratch);
+  };
+
+  // With --limit (and no --count) only the first offset + limit rows of the
+  // ordering matter.
+  const bool bounded = query.limit && !query.count;
+  const size_t wanted =
+      bounded ? windowEnd(query) : std::numeric_limits<size_t>::max();
+
+  if (bounded && query.sort == SortKey::none) {
+    selected.forEachSetBit([&](size_t row) {
+      if (rowMatches(row)) {
+        rows.push_back(row);
+      }
+      return rows.size() < wanted;
+    });
+    if (trace_) {
+      trace_->stage("scan",
+                    "bitmap walk in list order, stops after " +
+                        std::to_string(wanted) + " rows; " +
+                        textFilters(query),
+                    rows.size());
+    }
+  } else if (bounded && (query.sort == SortKey::priority ||
+                         query.sort == SortKey::done)) {
+    // Walking the flag bitmaps one sort key at a time, each in row order,
+    // gives the order of the stable full sort, so the walk can stop as soon
+    // as enough rows have matched.
+    std::vector<const Bitmap *> keys;
+    if (query.sort == SortKey::priority) {
+      for (const Bitmap &bits : priorityBits_) {
+        keys.push_back(&bits);
+      }
+    } else {
+      keys = {&doneBits_, &pendingBits_};
+    }
+    for (const Bitmap *bits : keys) {
+      if (rows.size() >= wanted) {
+        break;
+      }
+      Bitmap part = selected;
+      part &= *bits;
+      part.forEachSetBit([&](size_t row) {
+        if (rowMatches(row)) {
+          rows.push_back(row);
+        }
+        return rows.size() < wanted;
+      });
+    }
+    if (trace_) {
+      trace_->stage("scan",
+                    std::string(query.sort == SortKey::priority
+                                    ? "priority bitmaps"
+                                    : "done bitmaps") +
+                        " walked key by key in row order, stops after " +
+                        std::to_string(wanted) + " rows; " +
+                        textFilters(query),
+                    rows.size());
+    }
+  } else {
+    rows.reserve(selected.count());
+    selected.appendSetBits(rows);
+    if (category || !query.find.empty() || query.regex) {
+      filterRows(rows, chunksFor(rows.size()),
+                 [&](size_t row, std::string &rowScratch) {
+                   return matchesText(query, category, row, rowScratch);
+                 });
+      if (trace_) {
+        trace_->stage("filter",
+                      "full scan; " + textFilters(query) + "; " +
+                          std::to_string(chunksFor(selected.count())) +
+                          " thread(s)",
+                      rows.size());
+      }
+    }
+    if (query.sort == SortKey::id && bounded && wanted < rows.size()) {
+      std::partial_sort(rows.begin(), rows.begin() + wanted, rows.end(),
+                        [this](size_t i, size_t j) {
+                          return columns_.id(i) < columns_.id(j);
+                        });
+      if (trace_) {
+        trace_->stage("sort",
+                      "partial_sort on id, first " + std::to_string(wanted),
+                      rows.size());
+      }
+    } else {
+      sortRows(rows, query.sort);
+    }
+  }
+
+  applyWindowTraced(rows, query);
+  return rows;
+}
+std::vector<size_t>
+TaskManager::fuzzyRows(const LsQuery &query, const Bitmap &selected,
+                       std::optional<CategoryId> category) const {
+  const FuzzyPattern pattern(query.fuzzy);
+  // Without -s, matches are ranked by distance, ties in list order.
+  const bool ranked = query.sort == SortKey::none && !query.count;
+  const bool bounded = ranked && query.limit;
+  const size_t wanted = bounded ? windowEnd(query) : 0;
+  if (bounded && wanted == 0) {
+    return {};
+  }
+
+  // (distance, row). With --limit only the best `wanted` are kept, as a
+  // max-heap whose front is the worst of them.
+  std::vector<std::pair<unsigned, size_t>> hits;
+  if (!bounded) {
+    std::vector<size_t> candidates;
+    selected.appendSetBits(candidates);
+    std::vector<std::vector<std::pair<unsigned, size_t>>> found(
+        chunksFor(candidates.size()));
+    forEachChunk(candidates.size(), found.size(),
+                 [&](size_t begin, size_t end, size_t chunk) {
+                   std::string scratch;
+                   for (size_t i = begin; i < end; ++i) {
+                     const size_t row = candidates[i];
+                     if (!matchesText(query, category, row, scratch)) {
+                       continue;
+                     }
+                     const unsigned distance =
+                         pattern.distance(foldedText(row, scratch));
+                     if (distance <= pattern.maxErrors()) {
+                       found[chunk].emplace_back(distance, row);
+                     }
+                   }
+                 });
+    for (const auto &part : found) {
+      hits.insert(hits.end(), part.begin(), part.end());
+    }
+  } else {
+    std::string scratch;
+    selected.forEachSetBit([&](size_t row) {
+      if (!matchesText(query, category, row, scratch)) {
+        return true;
+      }
+      const unsigned distance = pattern.distance(foldedText(row, scratch));
+      if (distance > pattern.maxErrors()) {
+        return true;
+      }
+      if (hits.size() < wanted) {
+        hits.emplace_back(distance, row);
+        std::ranges::push_heap(hits);
+      } else if (distance < hits.front().first) {
+        std::ranges::pop_heap(hits);
+        hits.back() = {distance, row};
+        std::ranges::push_heap(hits);
+      }
+      // Rows arrive in list order, so once the kept rows are all exact
+      // matches no later row can displace one.
+      return hits.size() < wanted || hits.front().first > 0;
+    });
+  }
+  if (trace_) {
+    std::string plan =
+        bounded ? "bitmap walk into a top-" + std::to_string(wanted) + " heap"
+                : "bit-parallel scan on " +
+                      std::to_string(chunksFor(selected.count())) +
+                      " thread(s)";
+    plan += ", up to " + std::to_string(pattern.maxErrors()) + " errors; " +
+            textFilters(query);
+    trace_->stage("fuzzy", plan, hits.size());
+  }
+
+  if (ranked) {
+    std::ranges::sort(hits);
+    if (trace_) {
+      trace_->stage("sort", "by edit distance", hits.size());
+    }
+  }
+  std::vector<size_t> rows;
+  rows.reserve(hits.size());
+  for (const auto &hit : hits) {
+    rows.push_back(hit.second);
+  }
+  if (!ranked) {
+    sortRows(rows, query.sort);
+  }
+  applyWindowTraced(rows, query);
+  return rows;
+}
+size_t TaskManager::chunksFor(size_t rows) const {
+  if (rows < parallelThreshold_) {
+    return 1;
+  }
+  return std::max<size_t>(1, std::min(threads_, rows));
+}
+bool TaskManager::matchesFlags(const LsQuery &query, size_t row) const {
+  return flagsMatch(query, columns_.flags(row));
+}
+bool TaskManager::matchesText(const LsQuery &query,
+                              std::optional<CategoryId> category, size_t row,
+                              std::string &scratch) const {
+  if (category && columns_.category(row) != *category) {
+    return false;
+  }
+  if (query.find.empty() && !query.regex) {
+    return true;
+  }
+  // The needle is folded once by the parser; task text comes pre-folded
+  // from foldedText_ when the cache is on.
+  const std::string &folded = foldedText(row, scratch);
+  if (!query.find.empty() && folded.find(query.find) == std::string::npos) {
+    return false;
+  }
+  return !query.regex || query.regex->matches(tasks_[row].getText(), folded);
+}
+void TaskManager::sortRows(std::vector<size_t> &rows, SortKey key) const {
+  // All sort keys have small domains or fixed width, so full sorts are
+  // stable linear passes; ties stay in the order rows came in.
+  std::string how;
+  switch (key) {
+  case SortKey::id:
+    radixSortRows(rows, [this](size_t row) { return columns_.id(row); });
+    how = "radix sort on id";
+    break;
+  case SortKey::text:
+    how = "radix sort on 8-byte text keys, " +
+          std::to_string(sortTextTies(rows)) + " rows in tie runs";
+    break;
+  case SortKey::category: {
+    // Category ids are interned in arrival order; rank them by name once.
+    const std::vector<CategoryId> byName =
+        CategoryTable::shared().idsByName();
+    std::vector<size_t> rank(byName.size());
+    for (size_t i = 0; i < byName.size(); ++i) {
+      rank[byName[i]] = i;
+    }
+    countingSortRows(rows, rank.size(), [&](size_t row) {
+      return rank[columns_.category(row)];
+    });
+    how = "counting sort on category name rank";
+    break;
+  }
+  case SortKey::done:
+    countingSortRows(rows, 2, [this](size_t row) {
+      return doneSortKey(columns_.isDone(row));
+    });
+    how = "counting sort on done";
+    break;
+  case SortKey::priority:
+    countingSortRows(rows, 3, [this](size_t row) {
+      return static_cast<size_t>(columns_.priority(row));
+    });
+    how = "counting sort on priority";
+    break;
+  case SortKey::none:
+    return;
+  }
+  if (trace_) {
+    trace_->stage("sort", how, rows.size());
+  }
+}
+size_t TaskManager::sortTextTies(std::vector<size_t> &rows) const {
+  radixSortRows(rows, [this](size_t row) { return columns_.textKey(row); });
+  // Keys hold 8 bytes. A run of equal keys ending in a non-zero byte may
+  // differ further on, so only those runs compare the whole folded text.
+  size_t tied = 0;
+  std::string left;
+  std::string right;
+  for (size_t begin = 0; begin < rows.size();) {
+    const uint64_t key = columns_.textKey(rows[begin]);
+    size_t end = begin + 1;
+    while (end < rows.size() && columns_.textKey(rows[end]) == key) {
+      ++end;
+    }
+    if (end - begin > 1 && (key & 0xff) != 0) {
+      std::stable_sort(rows.begin() + begin, rows.begin() + end,
+                       [&](size_t a, size_t b) {
+                         return foldedText(a, left) < foldedText(b, right);
+                       });
+      tied += end - begin;
+    }
+    begin = end;
+  }
+  return tied;
+}
+void TaskManager::applyWindowTraced(std::vector<size_t> &rows,
+                                    const LsQuery &query) const {
+  if (query.count || (query.offset == 0 && !query.limit)) {
+    return;
+  }
+  applyWindow(rows, query);
+  if (trace_) {
+    trace_->stage("window",
+                  "offset " + std::to_string(query.offset) +
+                      (query.limit ? ", limit " + std::to_string(*query.limit)
+                                   : ""),
+                  rows.size());
+  }
+}
+void TaskManager::applyWindow(std::vector<size_t> &rows,
+                              const LsQuery &query) {
+  rows.erase(rows.begin(),
+             rows.begin() + static_cast<std::ptrdiff_t>(
+                                std::min(query.offset, rows.size())));
+  if (query.limit && rows.size() > *query.limit) {
+    rows.resize(*query.limit);
+  }
+}
+void TaskManager::printRows(std::span<const size_t> rows, bool color,
+                            size_t firstNumber) const {
+  OutputBuffer out(std::cout, renderBuffer_);
+  const auto &templates = rowTemplates(color);
+  size_t i = firstNumber;
+
+  for (size_t row : rows) {
+    const Task &task = tasks_[row];
+    out << i++ << " [id=" << task.getId() << "] ["
+        << std::string_view(task.getCategory())
+        << templates[task.getFlags()] << task.getText() << '\n';
+  }
+}
+void TaskManager::printJsonRows(std::span<const size_t> rows) const {
+  // Same fields and encoding as the entries of todo.json, written straight
+  // from the tasks without building a json value per row.
+  OutputBuffer out(std::cout, renderBuffer_);
+  for (size_t row : rows) {
+    const Task &task = tasks_[row];
+    out << "{\"id\":" << task.getId() << ",\"text\":";
+    writeJsonString(out, task.getText());
+    out << ",\"category\":";
+    writeJsonString(out, task.getCategory());
+    out << ",\"priority\":" << static_cast<int>(task.getPriority())
+        << ",\"done\":" << (task.isDone() ? "true" : "false") << "}\n";
+  }
+}
@@ -0,0 +1,105 @@
+#include "../include/Category.hpp"
+#include "../include/Query.hpp"
+#include "../include/TaskManager.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+void TaskManager::renderGroups(std::span<const size_t> rows,
+                               const LsQuery &query,
+                               size_t firstNumber) const {
+  // The category sort is stable, so each group stays in listing order.
+  std::vector<size_t> grouped(rows.begin(), rows.end());
+  sortRows(grouped, SortKey::category);
+
+  LsQuery ungrouped = query;
+  ungrouped.group = GroupKey::none;
+  size_t number = firstNumber;
+  for (size_t begin = 0; begin < grouped.size();) {
+    const CategoryId category = columns_.category(grouped[begin]);
+    size_t end = begin + 1;
+    while (end < grouped.size() &&
+           columns_.category(grouped[end]) == category) {
+      ++end;
+    }
+    // JSON Lines stays one object per line; each carries its category.
+    if (query.format == OutputFormat::human) {
+      std::cout << "== " << CategoryTable::shared().name(category) << " ("
+                << end - begin << ") ==\n";
+    }
+    renderRows(std::span<const size_t>(grouped).subspan(begin, end - begin),
+               ungrouped, number);
+    number += end - begin;
+    begin = end;
+  }
+}
+void TaskManager::printGroupCounts(
+    const std::vector<uint32_t> &perCategory) const {
+  for (CategoryId id : CategoryTable::shared().idsByName()) {
+    if (id < perCategory.size() && perCategory[id] != 0) {
+      std::cout << CategoryTable::shared().name(id) << ": " << perCategory[id]
+                << '\n';
+    }
+  }
+  std::cout << std::flush;
+}
+void TaskManager::stats() const {
+  if (tasks_.empty()) {
+    std::cout << "Todo List is empty!\n";
+    return;
+  }
+  const CategoryTable &table = CategoryTable::shared();
+  size_t width = std::string("category").size();
+  for (size_t id = 0; id < categoryStats_.size(); ++id) {
+    if (categoryStats_.total(static_cast<CategoryId>(id)) != 0) {
+      width = std::max(width, table.name(static_cast<CategoryId>(id)).size());
+    }
+  }
+
+  // total, done, pending, then pending per priority from high to low.
+  using Row = std::array<uint32_t, 6>;
+  auto printRow = [width](const std::string &name, const Row &row) {
+    std::cout << std::left << std::setw(static_cast<int>(width)) << name
+              << std::right;
+    for (uint32_t value : row) {
+      std::cout << std::setw(9) << value;
+    }
+    std::cout << '\n';
+  };
+  std::cout << std::left << std::setw(static_cast<int>(width)) << "category"
+            << std::right;
+  for (const char *column :
+       {"total", "done", "pending", "high", "medium", "low"}) {
+    std::cout << std::setw(9) << column;
+  }
+  std::cout << '\n';
+
+  Row all{};
+  for (CategoryId id : CategoryTable::shared().idsByName()) {
+    const CategoryStats::Counts &counts = categoryStats_.counts(id);
+    Row row{};
+    for (Priority priority :
+         {Priority::high, Priority::medium, Priority::low}) {
+      const uint32_t done = counts[Task::pack(priority, true)];
+      const uint32_t pending = counts[Task::pack(priority, false)];
+      row[0] += done + pending;
+      row[1] += done;
+      row[2] += pending;
+      row[5 - static_cast<size_t>(priority)] = pending;
+    }
+    if (row[0] == 0) {
+      continue;
+    }
+    printRow(table.name(id), row);
+    for (size_t i = 0; i < row.size(); ++i) {
+      all[i] += row[i];
+    }
+  }
+  printRow("all", all);
+  std::cout << std::flush;
+}
@@ -0,0 +1,88 @@
+#include "../include/TaskText.hpp"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+constexpr size_t kDataOffset = 0;
+constexpr size_t kResourceOffset = sizeof(char *);
+constexpr size_t kSizeOffset = kResourceOffset + sizeof(void *);
+} // namespace
+
+static_assert(kSizeOffset + sizeof(uint32_t) <= TaskText::kInlineCapacity);
+
+TaskText::TaskText(std::string_view text, std::pmr::memory_resource *resource) {
+  assign(text, resource);
+}
+TaskText::TaskText(const TaskText &other) {
+  assign(other.view(), std::pmr::get_default_resource());
+}
+TaskText::TaskText(TaskText &&other) noexcept { steal(other); }
+TaskText &TaskText::operator=(const TaskText &other) {
+  if (this != &other) {
+    TaskText copy(other);
+    release();
+    steal(copy);
+  }
+  return *this;
+}
+TaskText &TaskText::operator=(TaskText &&other) noexcept {
+  if (this != &other) {
+    release();
+    steal(other);
+  }
+  return *this;
+}
+const char *TaskText::largeData() const {
+  char *data;
+  std::memcpy(&data, bytes_ + kDataOffset, sizeof(data));
+  return data;
+}
+std::pmr::memory_resource *TaskText::largeResource() const {
+  std::pmr::memory_resource *resource;
+  std::memcpy(&resource, bytes_ + kResourceOffset, sizeof(resource));
+  return resource;
+}
+uint32_t TaskText::largeSize() const {
+  uint32_t size;
+  std::memcpy(&size, bytes_ + kSizeOffset, sizeof(size));
+  return size;
+}
+std::string_view TaskText::view() const {
+  if (isLarge()) {
+    return {largeData(), largeSize()};
+  }
+  return {reinterpret_cast<const char *>(bytes_), bytes_[kInlineCapacity]};
+}
+void TaskText::assign(std::string_view text,
+                      std::pmr::memory_resource *resource) {
+  if (text.size() <= kInlineCapacity) {
+    // An empty view may have a null data pointer, which memcpy rejects.
+    if (!text.empty()) {
+      std::memcpy(bytes_, text.data(), text.size());
+    }
+    bytes_[kInlineCapacity] = static_cast<unsigned char>(text.size());
+    return;
+  }
+  if (text.size() > std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("task text too long");
+  }
+  char *data = static_cast<char *>(resource->allocate(text.size(), 1));
+  std::memcpy(data, text.data(), text.size());
+  const uint32_t size = static_cast<uint32_t>(text.size());
+  std::memcpy(bytes_ + kDataOffset, &data, sizeof(data));
+  std::memcpy(bytes_ + kResourceOffset, &resource, sizeof(resource));
+  std::memcpy(bytes_ + kSizeOffset, &size, sizeof(size));
+  bytes_[kInlineCapacity] = kLargeTag;
+}
+void TaskText::release() {
+  if (isLarge()) {
+    largeResource()->deallocate(const_cast<char *>(largeData()), largeSize(),
+                                1);
+    bytes_[kInlineCapacity] = 0;
+  }
+}
+void TaskText::steal(TaskText &other) {
+  std::memcpy(bytes_, other.bytes_, sizeof(bytes_));
+  other.bytes_[kInlineCapacity] = 0;
+}
@@ -0,0 +1,134 @@
+#include "../include/Category.hpp"
+#include "../include/Query.hpp"
+#include "../include/TaskManager.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+CustomError TaskManager::saveView(const std::string &flag) {
+  const auto split = flag.find(' ');
+  const std::string name = trim(flag.substr(0, split));
+  const std::string options =
+      split == std::string::npos ? "" : trim(flag.substr(split + 1));
+  // The view subcommands cannot double as view names.
+  if (name.empty() || name == "save" || name == "del" || name == "list") {
+    return CustomError::ParseError;
+  }
+  std::optional<SavedView> view = compileView(options);
+  if (!view) {
+    return CustomError::ParseError;
+  }
+  rebuildSavedView(*view);
+  savedViews_[name] = std::move(*view);
+  return CustomError::Ok;
+}
+std::optional<SavedView>
+TaskManager::compileView(const std::string &options) {
+  std::optional<LsQuery> query = parseLsQuery(options);
+  if (!query) {
+    return std::nullopt;
+  }
+  SavedView view;
+  view.options = options;
+  view.query = std::move(*query);
+  if (view.query.category) {
+    view.category = CategoryTable::shared().intern(*view.query.category);
+  }
+  if (!view.query.fuzzy.empty()) {
+    view.fuzzy.emplace(view.query.fuzzy);
+  }
+  return view;
+}
+CustomError TaskManager::deleteView(const std::string &name) {
+  return savedViews_.erase(name) ? CustomError::Ok : CustomError::NoSuchView;
+}
+CustomError TaskManager::openView(const std::string &name) const {
+  auto it = savedViews_.find(name);
+  if (it == savedViews_.end()) {
+    return CustomError::NoSuchView;
+  }
+  const SavedView &view = it->second;
+  if (view.query.count) {
+    std::cout << view.members.size() << std::endl;
+    return CustomError::Ok;
+  }
+
+  // Only the view's own tasks are touched: look up their rows, put them in
+  // list order and apply the saved sort, offset and limit.
+  std::vector<size_t> rows;
+  rows.reserve(view.members.size());
+  for (uint64_t id : view.members) {
+    rows.push_back(rowById_.find(id)->second);
+  }
+  std::ranges::sort(rows);
+  if (view.fuzzy && view.query.sort == SortKey::none) {
+    // Distances are recomputed for the members only; ties stay in list
+    // order because rows is already sorted.
+    std::string scratch;
+    std::vector<std::pair<unsigned, size_t>> ranked;
+    ranked.reserve(rows.size());
+    for (size_t row : rows) {
+      ranked.emplace_back(view.fuzzy->distance(foldedText(row, scratch)), row);
+    }
+    std::ranges::sort(ranked);
+    for (size_t i = 0; i < rows.size(); ++i) {
+      rows[i] = ranked[i].second;
+    }
+  } else {
+    sortRows(rows, view.query.sort);
+  }
+  applyWindow(rows, view.query);
+  renderRows(rows, view.query, 1);
+  return CustomError::Ok;
+}
+void TaskManager::listViews() const {
+  if (savedViews_.empty()) {
+    std::cout << "No saved views\n";
+    return;
+  }
+  for (const auto &[name, view] : savedViews_) {
+    std::cout << name << " (" << view.members.size() << "): " << view.options
+              << '\n';
+  }
+}
+void TaskManager::refreshSavedViews(size_t index) {
+  if (savedViews_.empty()) {
+    return;
+  }
+  const uint64_t id = columns_.id(index);
+  std::string scratch;
+  for (auto &[name, view] : savedViews_) {
+    if (inSavedView(view, index, scratch)) {
+      view.members.insert(id);
+    } else {
+      view.members.erase(id);
+    }
+  }
+}
+void TaskManager::dropFromSavedViews(uint64_t id) {
+  for (auto &[name, view] : savedViews_) {
+    view.members.erase(id);
+  }
+}
+void TaskManager::rebuildSavedView(SavedView &view) {
+  view.members.clear();
+  std::string scratch;
+  for (size_t row = 0; row < columns_.size(); ++row) {
+    if (inSavedView(view, row, scratch)) {
+      view.members.insert(columns_.id(row));
+    }
+  }
+}
+bool TaskManager::inSavedView(const SavedView &view, size_t index,
+                              std::string &scratch) const {
+  if (!matchesFlags(view.query, index) ||
+      !matchesText(view.query, view.category, index, scratch)) {
+    return false;
+  }
+  return !view.fuzzy || view.fuzzy->distance(foldedText(index, scratch)) <=
+                            view.fuzzy->maxErrors();
+}
@@ -0,0 +1,75 @@
+#include "../include/UndoHistory.hpp"
+#include <algorithm>
+#include <utility>
+
+UndoHistory::UndoHistory(size_t depth, size_t budget)
+    : depth_(depth), budget_(budget) {}
+void UndoHistory::dropOldest() {
+  Entry &oldest = slot(0);
+  bytes_ -= oldest.bytes;
+  oldest.command.reset();
+  head_ = (head_ + 1) % ring_.size();
+  --size_;
+  ++evicted_;
+}
+bool UndoHistory::push(AnyCommand &&command) {
+  const size_t bytes =
+      visitCommand(command, [](const auto &held) { return held.footprint(); });
+  if (depth_ == 0) {
+    return false;
+  }
+  if (bytes > budget_) {
+    ++evicted_;
+    return false;
+  }
+  while (size_ == depth_ || bytes_ + bytes > budget_) {
+    dropOldest();
+  }
+  if (size_ == ring_.size()) {
+    resize(std::min(depth_, std::max<size_t>(16, 2 * ring_.size())));
+  }
+  Entry &newest = slot(size_);
+  newest.command.emplace(std::move(command));
+  newest.bytes = bytes;
+  ++size_;
+  bytes_ += bytes;
+  return true;
+}
+std::optional<AnyCommand> UndoHistory::pop() {
+  if (size_ == 0) {
+    return std::nullopt;
+  }
+  Entry &newest = slot(size_ - 1);
+  std::optional<AnyCommand> command = std::move(newest.command);
+  newest.command.reset();
+  bytes_ -= newest.bytes;
+  --size_;
+  return command;
+}
+void UndoHistory::setLimits(size_t depth, size_t budget) {
+  depth_ = depth;
+  budget_ = budget;
+  while (size_ > 0 && (size_ > depth_ || bytes_ > budget_)) {
+    dropOldest();
+  }
+  if (ring_.size() > depth_) {
+    resize(depth_);
+  }
+}
+void UndoHistory::resize(size_t slots) {
+  std::vector<Entry> ring(slots);
+  for (size_t age = 0; age < size_; ++age) {
+    ring[age].command.emplace(std::move(*slot(age).command));
+    ring[age].bytes = slot(age).bytes;
+  }
+  ring_ = std::move(ring);
+  head_ = 0;
+}
+void UndoHistory::clear() {
+  for (size_t age = 0; age < size_; ++age) {
+    slot(age).command.reset();
+  }
+  head_ = 0;
+  size_ = 0;
+  bytes_ = 0;
+}
@@ -2,7 +2,7 @@
 #include <algorithm>
 #include <iostream>
 
-std::string stringToLower(const std::string &text) {
+std::string stringToLower(std::string_view text) {
   std::string lowerText(text.size(), '\0');
   std::transform(text.begin(), text.end(), lowerText.begin(),
                  [](unsigned char c) { return std::tolower(c); });
@@ -24,6 +24,12 @@ void printError(const CustomError &err) {
   case CustomError::IoError:
     std::cout << "Error: Input/Output Error\n";
     return;
+  case CustomError::NoSuchView:
+    std::cout << "Error: No such view\n";
+    return;
+  case CustomError::AmbiguousTask:
+    std::cout << "Error: Several tasks match, see find-prefix\n";
+    return;
   }
 }
 std::string trim(const std::string &userInput) {
@@ -1,7 +1,6 @@
 #include "../include/Command.hpp"
 #include "../include/TaskManager.hpp"
 #include <iostream>
-#include <memory>
 #include <string>
 
 void printError(const CustomError &err);
@@ -32,33 +31,52 @@ int main() {
     } else if (cmd == "help") {
       manager.printHelp();
     } else if (cmd == "add") {
-      auto command = std::make_unique<AddCommand>(manager, flag);
-      printError(manager.executeCommand(std::move(command)));
+      printError(manager.execute<AddCommand>(flag));
       printError(manager.save(path));
     } else if (cmd == "edit") {
-      auto command = std::make_unique<EditCommand>(manager, flag);
-      printError(manager.executeCommand(std::move(command)));
+      printError(manager.execute<EditCommand>(flag));
       printError(manager.save(path));
     } else if (cmd == "undo") {
       manager.undo();
       manager.save(path);
+    } else if (cmd == "redo") {
+      manager.redo();
+      manager.save(path);
+    } else if (cmd == "set") {
+      printError(manager.setOption(flag));
     } else if (cmd == "ls") {
       manager.ls(flag);
+    } else if (cmd == "find-prefix") {
+      manager.findPrefix(flag);
+    } else if (cmd == "stats") {
+      manager.stats();
+    } else if (cmd == "view") {
+      auto split = flag.find(' ');
+      std::string sub = trim(flag.substr(0, split));
+      std::string rest =
+          split == std::string::npos ? "" : trim(flag.substr(split + 1));
+      if (sub == "save") {
+        printError(manager.saveView(rest));
+        printError(manager.save(path));
+      } else if (sub == "del") {
+        printError(manager.deleteView(rest));
+        printError(manager.save(path));
+      } else if (sub == "list") {
+        manager.listViews();
+      } else {
+        printError(manager.openView(flag));
+      }
     } else if (cmd == "done") {
-      auto command = std::make_unique<DoneCommand>(manager, flag);
-      printError(manager.executeCommand(std::move(command)));
+      printError(manager.execute<DoneCommand>(flag));
       printError(manager.save(path));
     } else if (cmd == "undone") {
-      auto command = std::make_unique<UndoneCommand>(manager, flag);
-      printError(manager.executeCommand(std::move(command)));
+      printError(manager.execute<UndoneCommand>(flag));
       printError(manager.save(path));
     } else if (cmd == "del") {
-      auto command = std::make_unique<DelCommand>(manager, flag);
-      printError(manager.executeCommand(std::move(command)));
+      printError(manager.execute<DelCommand>(flag));
       printError(manager.save(path));
     } else if (cmd == "clear") {
-      auto command = std::make_unique<ClearCommand>(manager);
-      printError(manager.executeCommand(std::move(command)));
+      printError(manager.execute<ClearCommand>());
       printError(manager.save(path));
     } else {
       std::cout << "Unknown command: " << cmd << std::endl;
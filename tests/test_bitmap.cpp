@@ -0,0 +1,60 @@
+#include "../include/Bitmap.hpp"
+#include "../include/catch.hpp"
+#include <vector>
+
+namespace {
+void requireSame(const Bitmap &bits, const std::vector<bool> &expected) {
+  REQUIRE(bits.size() == expected.size());
+  size_t ones = 0;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    REQUIRE(bits.test(i) == expected[i]);
+    ones += expected[i];
+  }
+  REQUIRE(bits.count() == ones);
+}
+} // namespace
+
+TEST_CASE("Bitmap insert and erase shift across words", "[Bitmap]") {
+  Bitmap bits;
+  std::vector<bool> expected;
+  for (size_t i = 0; i < 200; ++i) {
+    bits.push(i % 3 == 0);
+    expected.push_back(i % 3 == 0);
+  }
+  requireSame(bits, expected);
+
+  for (size_t pos : {0, 63, 64, 130, 202}) {
+    bits.insert(pos, true);
+    expected.insert(expected.begin() + pos, true);
+    requireSame(bits, expected);
+  }
+  for (size_t pos : {0, 63, 64, 127, 150}) {
+    bits.erase(pos);
+    expected.erase(expected.begin() + pos);
+    requireSame(bits, expected);
+  }
+  while (!expected.empty()) {
+    bits.erase(expected.size() - 1);
+    expected.pop_back();
+  }
+  requireSame(bits, expected);
+}
+
+TEST_CASE("Bitmap combines word-wise and lists set bits", "[Bitmap]") {
+  Bitmap a(130, true);
+  Bitmap b(130, false);
+  REQUIRE(a.count() == 130);
+  b.set(1, true);
+  b.set(64, true);
+  b.set(129, true);
+
+  a &= b;
+  std::vector<size_t> rows;
+  a.appendSetBits(rows);
+  REQUIRE(rows == std::vector<size_t>{1, 64, 129});
+
+  Bitmap c(130, false);
+  c.set(5, true);
+  c |= a;
+  REQUIRE(c.count() == 4);
+}
@@ -0,0 +1,24 @@
+#include "../include/CategoryStats.hpp"
+#include "../include/Task.hpp"
+#include "../include/catch.hpp"
+
+TEST_CASE("CategoryStats counts per category and flags", "[CategoryStats]") {
+  CategoryStats stats;
+  REQUIRE(stats.size() == 0);
+  REQUIRE(stats.total(3) == 0);
+
+  stats.add(3, Task::pack(Priority::high, false));
+  stats.add(3, Task::pack(Priority::high, false));
+  stats.add(3, Task::pack(Priority::low, true));
+  stats.add(1, Task::pack(Priority::medium, false));
+  REQUIRE(stats.size() == 4);
+  REQUIRE(stats.total(3) == 3);
+  REQUIRE(stats.total(1) == 1);
+  REQUIRE(stats.total(2) == 0);
+  REQUIRE(stats.counts(3)[Task::pack(Priority::high, false)] == 2);
+
+  stats.remove(3, Task::pack(Priority::high, false));
+  REQUIRE(stats.total(3) == 2);
+  stats.clear();
+  REQUIRE(stats.total(3) == 0);
+}
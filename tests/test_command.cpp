@@ -175,3 +175,159 @@ TEST_CASE("executeCommand does not push failed commands", "[Command]") {
 
   removeFile(path);
 }
+
+TEST_CASE("Undo history honours undo-depth and undo-memory", "[Command]") {
+  const std::string path = makeTempPath("undo_limits");
+  removeFile(path);
+
+  TaskManager manager(path);
+  REQUIRE(manager.setOption("undo-depth 2") == CustomError::Ok);
+  for (const char *text : {"one", "two", "three"}) {
+    auto cmd = std::make_unique<AddCommand>(manager, text);
+    REQUIRE(manager.executeCommand(std::move(cmd)) == CustomError::Ok);
+  }
+  REQUIRE(manager.undoHistory().size() == 2);
+  REQUIRE(manager.undoHistory().evicted() == 1);
+  manager.undo();
+  manager.undo();
+  manager.undo();
+  REQUIRE(manager.save(path) == CustomError::Ok);
+  json data = loadJson(path);
+  REQUIRE(data["tasks"].size() == 1);
+  REQUIRE(data["tasks"][0]["text"].get<std::string>() == "one");
+
+  // A clear of many long tasks outgrows a 1 KiB budget and is not kept.
+  REQUIRE(manager.setOption("undo-memory 1") == CustomError::Ok);
+  for (int i = 0; i < 40; ++i) {
+    manager.add("a task text longer than the inline buffer " +
+                std::to_string(i));
+  }
+  auto clear = std::make_unique<ClearCommand>(manager);
+  REQUIRE(manager.executeCommand(std::move(clear)) == CustomError::Ok);
+  REQUIRE(manager.undoHistory().empty());
+  REQUIRE(manager.undoHistory().bytes() == 0);
+  REQUIRE(manager.setOption("undo-memory x") == CustomError::ParseError);
+  REQUIRE(manager.setOption("undo-memory 18446744073709551615") ==
+          CustomError::Ok);
+  REQUIRE(manager.undoHistory().budget() >= (size_t{1} << 60));
+  REQUIRE(manager.setOption("undo-depth 1000000000000") == CustomError::Ok);
+
+  REQUIRE(manager.setOption("undo-depth 0") == CustomError::Ok);
+  const size_t evicted = manager.undoHistory().evicted();
+  auto add = std::make_unique<AddCommand>(manager, "kept");
+  REQUIRE(manager.executeCommand(std::move(add)) == CustomError::Ok);
+  REQUIRE(manager.undoHistory().empty());
+  REQUIRE(manager.undoHistory().evicted() == evicted);
+
+  removeFile(path);
+}
+
+TEST_CASE("Redo repeats undone commands until a new command runs",
+          "[Command]") {
+  const std::string path = makeTempPath("redo");
+  removeFile(path);
+
+  TaskManager manager(path);
+  auto texts = [&] {
+    REQUIRE(manager.save(path) == CustomError::Ok);
+    const json data = loadJson(path);
+    std::string joined;
+    for (const auto &task : data["tasks"]) {
+      joined += task["text"].get<std::string>();
+      joined += task["done"].get<bool>() ? "+ " : " ";
+    }
+    return joined;
+  };
+  auto run = [&](std::unique_ptr<Command> command) {
+    REQUIRE(manager.executeCommand(std::move(command)) == CustomError::Ok);
+  };
+  run(std::make_unique<AddCommand>(manager, "a"));
+  run(std::make_unique<AddCommand>(manager, "b"));
+  run(std::make_unique<EditCommand>(manager, "1 alpha"));
+  run(std::make_unique<DoneCommand>(manager, "2"));
+  run(std::make_unique<DelCommand>(manager, "1"));
+  run(std::make_unique<ClearCommand>(manager));
+  REQUIRE(texts() == "");
+
+  for (int i = 0; i < 6; ++i) {
+    manager.undo();
+  }
+  REQUIRE(texts() == "");
+  manager.redo();
+  manager.redo();
+  REQUIRE(texts() == "a b ");
+  manager.redo();
+  manager.redo();
+  REQUIRE(texts() == "alpha b+ ");
+  manager.redo();
+  REQUIRE(texts() == "b+ ");
+  manager.redo();
+  REQUIRE(texts() == "");
+  manager.undo();
+  manager.undo();
+  REQUIRE(texts() == "alpha b+ ");
+
+  // A new command drops what was left to redo.
+  run(std::make_unique<UndoneCommand>(manager, "2"));
+  manager.redo();
+  REQUIRE(texts() == "alpha b ");
+  REQUIRE(manager.undoHistory().size() == 5);
+
+  removeFile(path);
+}
+
+TEST_CASE("Commands keep ids instead of their typed input", "[Command]") {
+  const std::string path = makeTempPath("compact");
+  removeFile(path);
+
+  TaskManager manager(path);
+  const std::string longText(200, 'x');
+  manager.add("short");
+  DoneCommand done(manager, "1" + std::string(100, ' '));
+  REQUIRE(done.execute() == CustomError::Ok);
+  REQUIRE(done.footprint() == sizeof(DoneCommand));
+
+  EditCommand edit(manager, "1 " + longText);
+  REQUIRE(edit.execute() == CustomError::Ok);
+  REQUIRE(edit.footprint() == sizeof(EditCommand));
+  REQUIRE(edit.undo() == CustomError::Ok);
+  REQUIRE(edit.footprint() == sizeof(EditCommand) + longText.size());
+
+  removeFile(path);
+}
+
+TEST_CASE("execute keeps commands inline next to adapted ones", "[Command]") {
+  const std::string path = makeTempPath("inline");
+  removeFile(path);
+
+  TaskManager manager(path);
+  REQUIRE(manager.execute<AddCommand>("home:high:Paint") == CustomError::Ok);
+  REQUIRE(manager.executeCommand(std::make_unique<AddCommand>(
+              manager, "Shop")) == CustomError::Ok);
+  REQUIRE(manager.execute<DoneCommand>("paint") == CustomError::Ok);
+  REQUIRE(manager.execute<EditCommand>("2 Shop for bread") ==
+          CustomError::Ok);
+  REQUIRE(manager.execute<DelCommand>("9") == CustomError::NoSuchTask);
+  REQUIRE(manager.undoHistory().size() == 4);
+
+  manager.undo();
+  manager.undo();
+  REQUIRE(manager.getTaskDoneStatus("1") == false);
+  manager.redo();
+  REQUIRE(manager.getTaskDoneStatus("1") == true);
+  manager.undo();
+  manager.undo();
+  manager.undo();
+  REQUIRE(manager.save(path) == CustomError::Ok);
+  REQUIRE(loadJson(path)["tasks"].empty());
+  manager.redo();
+  manager.redo();
+  manager.redo();
+  manager.redo();
+  REQUIRE(manager.save(path) == CustomError::Ok);
+  json data = loadJson(path);
+  REQUIRE(data["tasks"].size() == 2);
+  REQUIRE(data["tasks"][1]["text"].get<std::string>() == "Shop for bread");
+
+  removeFile(path);
+}
@@ -0,0 +1,65 @@
+#include "../include/Fuzzy.hpp"
+#include "../include/catch.hpp"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+// Textbook O(n*m) table: best edit distance of pattern against any
+// substring of text.
+unsigned naiveDistance(const std::string &pattern, const std::string &text) {
+  std::vector<unsigned> column(pattern.size() + 1);
+  for (size_t i = 0; i <= pattern.size(); ++i) {
+    column[i] = static_cast<unsigned>(i);
+  }
+  unsigned best = column.back();
+  for (char c : text) {
+    unsigned diagonal = column[0];
+    for (size_t i = 1; i <= pattern.size(); ++i) {
+      const unsigned up = column[i];
+      column[i] = std::min({up + 1, column[i - 1] + 1,
+                            diagonal + (pattern[i - 1] == c ? 0u : 1u)});
+      diagonal = up;
+    }
+    best = std::min(best, column.back());
+  }
+  return best;
+}
+} // namespace
+
+TEST_CASE("FuzzyPattern tolerates typos", "[Fuzzy]") {
+  FuzzyPattern meeting("meeting");
+  REQUIRE(meeting.maxErrors() == 1);
+  REQUIRE(meeting.distance("team meeting at 10") == 0);
+  REQUIRE(meeting.distance("team meting at 10") == 1);
+  REQUIRE(meeting.distance("team metting at 10") == 1);
+  REQUIRE(meeting.distance("team meetxxg at 10") == 2);
+  REQUIRE(meeting.distance("mee") == 2);
+
+  FuzzyPattern short3("tax");
+  REQUIRE(short3.maxErrors() == 0);
+  REQUIRE(short3.distance("pay taxes") == 0);
+  REQUIRE(short3.distance("pay tix") == 1);
+}
+
+TEST_CASE("FuzzyPattern agrees with the dynamic programming table",
+          "[Fuzzy]") {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> letter('a', 'd');
+  auto randomText = [&](size_t length) {
+    std::string text;
+    for (size_t i = 0; i < length; ++i) {
+      text += static_cast<char>(letter(rng));
+    }
+    return text;
+  };
+  for (int round = 0; round < 2000; ++round) {
+    const std::string pattern = randomText(1 + rng() % 64);
+    const std::string text = randomText(rng() % 80);
+    FuzzyPattern fuzzy(pattern);
+    const unsigned expected =
+        std::min(naiveDistance(pattern, text), fuzzy.maxErrors() + 1);
+    REQUIRE(fuzzy.distance(text) == expected);
+  }
+}
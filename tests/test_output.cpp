@@ -0,0 +1,62 @@
+#include "../include/Color.hpp"
+#include "../include/Output.hpp"
+#include "../include/catch.hpp"
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace {
+// Records how many bulk writes reach the stream.
+struct CountingBuf : std::stringbuf {
+  int writes = 0;
+  std::streamsize xsputn(const char *s, std::streamsize n) override {
+    ++writes;
+    return std::stringbuf::xsputn(s, n);
+  }
+};
+} // namespace
+
+TEST_CASE("OutputBuffer formats into one write", "[Output]") {
+  CountingBuf buf;
+  std::ostream os(&buf);
+  std::string storage;
+  {
+    OutputBuffer out(os, storage);
+    for (uint64_t i = 1; i <= 100; ++i) {
+      out << i << ' ' << "row" << '\n';
+    }
+    REQUIRE(buf.writes == 0);
+  }
+  REQUIRE(buf.writes == 1);
+  REQUIRE(buf.str().rfind("100 row\n") == buf.str().size() - 8);
+  REQUIRE(buf.str().find("1 row\n2 row\n") == 0);
+}
+
+TEST_CASE("OutputBuffer flushes past its threshold", "[Output]") {
+  CountingBuf buf;
+  std::ostream os(&buf);
+  std::string storage;
+  {
+    OutputBuffer out(os, storage, 16);
+    for (int i = 0; i < 10; ++i) {
+      Color color(out, "31");
+      out << "abcdef";
+    }
+  }
+  REQUIRE(buf.writes > 1);
+  REQUIRE(buf.writes < 10);
+  REQUIRE(buf.str().find("\033[31mabcdef\033[0m") == 0);
+  REQUIRE(buf.str().size() == 10 * 15);
+}
+
+TEST_CASE("writeJsonString escapes quotes, backslashes and controls",
+          "[Output]") {
+  std::ostringstream os;
+  std::string storage;
+  {
+    OutputBuffer out(os, storage);
+    writeJsonString(out, "say \"hi\"\\ \n\t\x01 ☐");
+  }
+  REQUIRE(os.str() == "\"say \\\"hi\\\"\\\\ \\n\\t\\u0001 ☐\"");
+}
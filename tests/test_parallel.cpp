@@ -0,0 +1,41 @@
+#include "../include/Parallel.hpp"
+#include "../include/catch.hpp"
+#include <atomic>
+#include <string>
+#include <vector>
+
+TEST_CASE("forEachChunk covers every index exactly once", "[Parallel]") {
+  for (size_t chunks : {1, 3, 8}) {
+    std::vector<std::atomic<int>> seen(1001);
+    forEachChunk(seen.size(), chunks, [&](size_t begin, size_t end, size_t) {
+      for (size_t i = begin; i < end; ++i) {
+        ++seen[i];
+      }
+    });
+    for (const auto &count : seen) {
+      REQUIRE(count == 1);
+    }
+  }
+}
+
+TEST_CASE("filterRows keeps order for any thread count", "[Parallel]") {
+  std::vector<size_t> all;
+  for (size_t row = 0; row < 997; ++row) {
+    all.push_back(row * 3);
+  }
+  std::vector<size_t> expected;
+  for (size_t row : all) {
+    if (row % 7 < 3) {
+      expected.push_back(row);
+    }
+  }
+  for (size_t threads : {0, 1, 2, 5, 16}) {
+    std::vector<size_t> rows = all;
+    filterRows(rows, threads,
+               [](size_t row, std::string &) { return row % 7 < 3; });
+    REQUIRE(rows == expected);
+  }
+  std::vector<size_t> empty;
+  filterRows(empty, 4, [](size_t, std::string &) { return true; });
+  REQUIRE(empty.empty());
+}
@@ -0,0 +1,44 @@
+#include "../include/PrefixIndex.hpp"
+#include "../include/catch.hpp"
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+std::set<uint64_t> idsIn(const PrefixIndex::Range &range) {
+  std::set<uint64_t> ids;
+  for (auto it = range.begin; it != range.end; ++it) {
+    ids.insert(it->second);
+  }
+  return ids;
+}
+} // namespace
+
+TEST_CASE("indexWords splits on punctuation and spaces", "[PrefixIndex]") {
+  REQUIRE(indexWords("buy milk, 2l!") ==
+          std::vector<std::string_view>{"buy", "milk", "2l"});
+  REQUIRE(indexWords("  ").empty());
+  REQUIRE(indexWords("caf\xc3\xa9 au lait") ==
+          std::vector<std::string_view>{"caf\xc3\xa9", "au", "lait"});
+}
+
+TEST_CASE("PrefixIndex finds prefix ranges", "[PrefixIndex]") {
+  PrefixIndex index;
+  index.add(1, "buy milk");
+  index.add(2, "build shed");
+  index.add(3, "call mum");
+  index.add(4, "bu");
+  REQUIRE(index.size() == 7);
+
+  PrefixIndex::Range b = index.find("b");
+  REQUIRE(idsIn(b) == std::set<uint64_t>{1, 2, 4});
+  REQUIRE(idsIn(index.find("bui")) == std::set<uint64_t>{2});
+  REQUIRE(index.find("buix").empty());
+
+  REQUIRE(idsIn(index.find("m")) == std::set<uint64_t>{1, 3});
+  index.remove(1, "buy milk");
+  REQUIRE(idsIn(index.find("m")) == std::set<uint64_t>{3});
+  REQUIRE(idsIn(index.find("")).size() == 3);
+  REQUIRE(index.find("\xff").empty());
+}
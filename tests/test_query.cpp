@@ -0,0 +1,93 @@
+#include "../include/Query.hpp"
+#include "../include/catch.hpp"
+#include <string>
+
+TEST_CASE("parseLsQuery combines filters", "[Query]") {
+  auto query = parseLsQuery("-p -h -m --count");
+  REQUIRE(query.has_value());
+  REQUIRE(query->done == false);
+  REQUIRE(query->priorities == 0b110);
+  REQUIRE(query->count);
+  REQUIRE(query->sort == SortKey::none);
+  REQUIRE(!query->explain);
+  REQUIRE(parseLsQuery("--explain -p")->explain);
+  REQUIRE(normalizedKey(*parseLsQuery("--explain -p")) ==
+          normalizedKey(*parseLsQuery("-p")));
+}
+
+TEST_CASE("parseLsQuery reads sort key and multi-word search",
+          "[Query]") {
+  auto query = parseLsQuery("--find Buy MILK -s priority");
+  REQUIRE(query.has_value());
+  REQUIRE(query->find == "buy milk");
+  REQUIRE(query->sort == SortKey::priority);
+  REQUIRE(!query->done.has_value());
+
+  REQUIRE(parseLsQuery("")->priorities == 0);
+  REQUIRE(!parseLsQuery("-s").has_value());
+  REQUIRE(!parseLsQuery("-s name").has_value());
+  REQUIRE(parseLsQuery("-s text")->sort == SortKey::text);
+  REQUIRE(parseLsQuery("--sort category")->sort == SortKey::category);
+  REQUIRE(!parseLsQuery("-f").has_value());
+  REQUIRE(parseLsQuery("-c work")->category == "work");
+  REQUIRE(!parseLsQuery("--category").has_value());
+  REQUIRE(!parseLsQuery("--bogus").has_value());
+}
+
+TEST_CASE("parseLsQuery reads fuzzy search text", "[Query]") {
+  auto query = parseLsQuery("--fuzzy Team Meting -p");
+  REQUIRE(query.has_value());
+  REQUIRE(query->fuzzy == "team meting");
+  REQUIRE(query->find.empty());
+  REQUIRE(query->done == false);
+  REQUIRE(!parseLsQuery("--fuzzy").has_value());
+  REQUIRE(!parseLsQuery("--fuzzy " + std::string(65, 'a')).has_value());
+  REQUIRE(normalizedKey(*parseLsQuery("--fuzzy ab")) !=
+          normalizedKey(*parseLsQuery("-f ab")));
+}
+
+TEST_CASE("parseLsQuery compiles --regex once", "[Query]") {
+  auto query = parseLsQuery("--regex ^Pay .* bill$ -p");
+  REQUIRE(query.has_value());
+  REQUIRE(query->regex);
+  REQUIRE(query->regex->pattern() == "^Pay .* bill$");
+  REQUIRE(query->done == false);
+  LsQuery copy = *query;
+  REQUIRE(copy.regex == query->regex);
+  REQUIRE(!parseLsQuery("--regex").has_value());
+  REQUIRE(!parseLsQuery("--regex a[b").has_value());
+  REQUIRE(normalizedKey(*parseLsQuery("--regex ab")) !=
+          normalizedKey(*parseLsQuery("-f ab")));
+}
+
+TEST_CASE("parseLsQuery reads limit and offset", "[Query]") {
+  auto query = parseLsQuery("-s priority --limit 20 --offset 40");
+  REQUIRE(query.has_value());
+  REQUIRE(query->limit == 20u);
+  REQUIRE(query->offset == 40u);
+  REQUIRE(!parseLsQuery("").value().limit.has_value());
+  REQUIRE(!parseLsQuery("--limit").has_value());
+  REQUIRE(!parseLsQuery("--limit -1").has_value());
+  REQUIRE(!parseLsQuery("--offset 2x").has_value());
+}
+
+TEST_CASE("parseLsQuery reads output format", "[Query]") {
+  REQUIRE(parseLsQuery("--format=jsonl")->format == OutputFormat::jsonl);
+  REQUIRE(parseLsQuery("--format jsonl")->format == OutputFormat::jsonl);
+  REQUIRE(parseLsQuery("")->format == OutputFormat::human);
+  REQUIRE(!parseLsQuery("--format=xml").has_value());
+  REQUIRE(!parseLsQuery("--format").has_value());
+  REQUIRE(parseLsQuery("--pager --plain")->pager);
+}
+
+TEST_CASE("normalizedKey ignores option order and output options",
+          "[Query]") {
+  REQUIRE(normalizedKey(*parseLsQuery("-p -h -s id")) ==
+          normalizedKey(*parseLsQuery("-s id -h -p --plain --format=jsonl")));
+  REQUIRE(normalizedKey(*parseLsQuery("-p")) !=
+          normalizedKey(*parseLsQuery("-d")));
+  REQUIRE(normalizedKey(*parseLsQuery("-c a -f b")) !=
+          normalizedKey(*parseLsQuery("-c a;b")));
+  REQUIRE(normalizedKey(*parseLsQuery("--limit 5")) !=
+          normalizedKey(*parseLsQuery("--offset 5")));
+}
@@ -0,0 +1,36 @@
+#include "../include/QueryCache.hpp"
+#include "../include/catch.hpp"
+#include <vector>
+
+TEST_CASE("QueryCache returns rows only for the same version",
+          "[QueryCache]") {
+  QueryCache cache(4);
+  cache.insert("a", 1, {1, 2, 3});
+
+  const std::vector<size_t> *rows = cache.find("a", 1);
+  REQUIRE(rows != nullptr);
+  REQUIRE(*rows == std::vector<size_t>{1, 2, 3});
+  REQUIRE(cache.hits() == 1);
+
+  REQUIRE(cache.find("a", 2) == nullptr);
+  REQUIRE(cache.size() == 0);
+  REQUIRE(cache.find("b", 1) == nullptr);
+}
+
+TEST_CASE("QueryCache evicts the least recently used entry", "[QueryCache]") {
+  QueryCache cache(2);
+  cache.insert("a", 1, {1});
+  cache.insert("b", 1, {2});
+  REQUIRE(cache.find("a", 1) != nullptr);
+  cache.insert("c", 1, {3});
+
+  REQUIRE(cache.size() == 2);
+  REQUIRE(cache.find("b", 1) == nullptr);
+  REQUIRE(cache.find("a", 1) != nullptr);
+  REQUIRE(cache.find("c", 1) != nullptr);
+
+  cache.setCapacity(0);
+  REQUIRE(cache.size() == 0);
+  cache.insert("d", 1, {4});
+  REQUIRE(cache.find("d", 1) == nullptr);
+}
@@ -0,0 +1,29 @@
+#include "../include/QueryTrace.hpp"
+#include "../include/catch.hpp"
+#include <sstream>
+#include <string>
+
+TEST_CASE("QueryTrace records stages in order and prints them",
+          "[QueryTrace]") {
+  QueryTrace trace;
+  trace.stage("select", "all rows", 10);
+  trace.stage("sort", "radix sort on id", 10);
+  trace.stage("parse", "ls options");
+  REQUIRE(trace.size() == 3);
+  REQUIRE(trace.name(1) == "sort");
+  REQUIRE(trace.detail(1) == "radix sort on id");
+
+  std::ostringstream out;
+  out << 1.5;
+  trace.print(out);
+  const std::string text = out.str();
+  REQUIRE(text.find("-- plan --") != std::string::npos);
+  REQUIRE(text.find("select") < text.find("sort"));
+  REQUIRE(text.find("radix sort on id\n") != std::string::npos);
+  REQUIRE(text.find("total") != std::string::npos);
+
+  // The stream's number formatting is left as it was.
+  out.str("");
+  out << 1.5;
+  REQUIRE(out.str() == "1.5");
+}
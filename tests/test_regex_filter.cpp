@@ -0,0 +1,60 @@
+#include "../include/RegexFilter.hpp"
+#include "../include/catch.hpp"
+#include "../include/Utils.hpp"
+#include <string>
+#include <vector>
+
+using Literals = std::vector<std::string>;
+
+TEST_CASE("requiredLiterals keeps only text every match contains",
+          "[RegexFilter]") {
+  REQUIRE(requiredLiterals("invoice") == Literals{"invoice"});
+  REQUIRE(requiredLiterals("^pay .* bill$") == Literals{"pay ", " bill"});
+  REQUIRE(requiredLiterals("colou?r") == Literals{"colo", "r"});
+  REQUIRE(requiredLiterals("ab+c") == Literals{"ab", "c"});
+  REQUIRE(requiredLiterals("ab*c") == Literals{"a", "c"});
+  REQUIRE(requiredLiterals("v\\d+\\.0") == Literals{"v", ".0"});
+  REQUIRE(requiredLiterals("inv(oice|oise) [a-z]x") ==
+          Literals{"inv", " ", "x"});
+  REQUIRE(requiredLiterals("[]x] y") == Literals{" y"});
+  REQUIRE(requiredLiterals("a\\.?b") == Literals{"a", "b"});
+  REQUIRE(requiredLiterals("cat|dog").empty());
+  REQUIRE(requiredLiterals("\\w+").empty());
+  REQUIRE(requiredLiterals("a{2}b") == Literals{"b"});
+  REQUIRE(requiredLiterals("fo{1,3}bar") == Literals{"f", "bar"});
+  REQUIRE(requiredLiterals("\\x41pple") == Literals{"pple"});
+  REQUIRE(requiredLiterals("\\u0041b\\cJc") == Literals{"b", "c"});
+}
+
+TEST_CASE("RegexFilter keeps matches of counted quantifiers and escapes",
+          "[RegexFilter]") {
+  auto matches = [](const std::string &pattern, const std::string &text) {
+    auto filter = RegexFilter::compile(pattern);
+    REQUIRE(filter.has_value());
+    return filter->matches(text, stringToLower(text));
+  };
+  REQUIRE(matches("a{2}b", "aab"));
+  REQUIRE_FALSE(matches("a{2}b", "ab"));
+  REQUIRE(matches("fo{1,3}bar", "fooobar"));
+  REQUIRE(matches("(ab){2,}", "xababx"));
+  REQUIRE(matches("\\x41pple", "Apple"));
+  REQUIRE(matches("\\u0041pple", "apple pie"));
+  REQUIRE_FALSE(matches("\\x41pple", "Bpple"));
+}
+
+TEST_CASE("RegexFilter matches case-insensitively after the prefilter",
+          "[RegexFilter]") {
+  auto filter = RegexFilter::compile("Inv(oice|oise) #\\d+");
+  REQUIRE(filter.has_value());
+  REQUIRE(filter->literals() == Literals{"inv", " #"});
+
+  auto matches = [&](const std::string &text) {
+    return filter->matches(text, stringToLower(text));
+  };
+  REQUIRE(matches("Send INVOICE #12"));
+  REQUIRE(matches("send invoise #3 today"));
+  REQUIRE_FALSE(matches("send invoice #x"));
+  REQUIRE_FALSE(matches("send bill #12"));
+
+  REQUIRE_FALSE(RegexFilter::compile("(unclosed").has_value());
+}
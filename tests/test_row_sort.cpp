@@ -0,0 +1,37 @@
+#include "../include/RowSort.hpp"
+#include "../include/catch.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("countingSortRows is stable", "[RowSort]") {
+  const std::vector<size_t> keys = {2, 0, 1, 0, 2, 1, 0};
+  std::vector<size_t> rows = {0, 1, 2, 3, 4, 5, 6};
+  countingSortRows(rows, 3, [&keys](size_t row) { return keys[row]; });
+  REQUIRE(rows == std::vector<size_t>{1, 3, 6, 2, 5, 0, 4});
+}
+
+TEST_CASE("radixSortRows matches stable_sort on wide keys", "[RowSort]") {
+  std::vector<uint64_t> keys;
+  uint64_t x = 88172645463325252ull;
+  for (size_t i = 0; i < 1000; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    keys.push_back(i % 5 == 0 ? keys.size() % 7 : x);
+  }
+  std::vector<size_t> rows;
+  for (size_t i = 0; i < keys.size(); i += 2) {
+    rows.push_back(i);
+  }
+  std::vector<size_t> expected = rows;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+  radixSortRows(rows, [&keys](size_t row) { return keys[row]; });
+  REQUIRE(rows == expected);
+
+  std::vector<size_t> empty;
+  radixSortRows(empty, [&keys](size_t row) { return keys[row]; });
+  REQUIRE(empty.empty());
+}
@@ -32,3 +32,16 @@ TEST_CASE("Task priority string matches enum", "[Task]") {
   REQUIRE(mediumTask.getPriorityString() == "medium");
   REQUIRE(highTask.getPriorityString() == "high");
 }
+
+TEST_CASE("Task interns its category", "[Task]") {
+  Task first(1, "a", "errands");
+  Task second(2, "b", "errands");
+  Task other(3, "c", "garden");
+
+  REQUIRE(first.getCategoryId() == second.getCategoryId());
+  REQUIRE(first.getCategoryId() != other.getCategoryId());
+  REQUIRE(&first.getCategory() == &second.getCategory());
+  REQUIRE(second.getCategory() == "errands");
+  REQUIRE(CategoryTable::shared().find("garden") == other.getCategoryId());
+  REQUIRE(!CategoryTable::shared().find("no such category").has_value());
+}
@@ -0,0 +1,41 @@
+#include "../include/TaskColumns.hpp"
+#include "../include/catch.hpp"
+
+TEST_CASE("TaskColumns packs priority and done into one byte",
+          "[TaskColumns]") {
+  TaskColumns columns;
+  columns.push(Task(1, "a", "general", Priority::high, true));
+  columns.push(Task(2, "b", "general", Priority::low, false));
+
+  REQUIRE(columns.size() == 2);
+  REQUIRE(columns.id(0) == 1);
+  REQUIRE(columns.priority(0) == Priority::high);
+  REQUIRE(columns.isDone(0));
+  REQUIRE(columns.priority(1) == Priority::low);
+  REQUIRE(!columns.isDone(1));
+
+  columns.setDone(1, true);
+  REQUIRE(columns.isDone(1));
+  REQUIRE(columns.priority(1) == Priority::low);
+}
+
+TEST_CASE("TaskColumns keeps 8-byte text keys in row order",
+          "[TaskColumns]") {
+  REQUIRE(TaskColumns::collationKey("Abc") == TaskColumns::collationKey("aBC"));
+  REQUIRE(TaskColumns::collationKey("ab") < TaskColumns::collationKey("abc"));
+  REQUIRE(TaskColumns::collationKey("abcdefgh") ==
+          TaskColumns::collationKey("ABCDEFGHxyz"));
+  REQUIRE(TaskColumns::collationKey("b") > TaskColumns::collationKey("azzz"));
+
+  TaskColumns columns;
+  columns.push(Task(1, "b", "general", Priority::low, false));
+  columns.push(Task(2, "c", "general", Priority::low, false));
+  columns.insert(0, Task(3, "a", "general", Priority::low, false));
+  REQUIRE(columns.textKey(0) == TaskColumns::collationKey("a"));
+  REQUIRE(columns.textKey(2) == TaskColumns::collationKey("c"));
+
+  columns.erase(1);
+  columns.setText(0, "Zed");
+  REQUIRE(columns.textKey(0) == TaskColumns::collationKey("zed"));
+  REQUIRE(columns.textKey(1) == TaskColumns::collationKey("c"));
+}
@@ -1,9 +1,15 @@
 #include "../include/TaskManager.hpp"
 #include "../include/catch.hpp"
 #include "../include/json.hpp"
+#include <algorithm>
 #include <cstdio>
 #include <fstream>
+#include <iostream>
+#include <sstream>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -21,6 +27,20 @@ json loadJson(const std::string &path) {
   file >> data;
   return data;
 }
+
+struct StreamCapture {
+  std::ostream &target;
+  std::ostringstream stream;
+  std::streambuf *old;
+  explicit StreamCapture(std::ostream &out)
+      : target(out), old(out.rdbuf(stream.rdbuf())) {}
+  ~StreamCapture() { target.rdbuf(old); }
+  std::string str() const { return stream.str(); }
+};
+
+struct CoutCapture : StreamCapture {
+  CoutCapture() : StreamCapture(std::cout) {}
+};
 } // namespace
 
 TEST_CASE("TaskManager add parses category and priority", "[TaskManager]") {
@@ -197,3 +217,954 @@ TEST_CASE("TaskManager save returns IoError on invalid path", "[TaskManager]") {
 
   removeFile(path);
 }
+
+TEST_CASE("TaskManager find uses folded text with cache on and off",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("fold");
+  removeFile(path);
+
+  TaskManager manager(path);
+  REQUIRE(manager.foldCache());
+  manager.add("Buy MILK");
+  manager.add("Call mom");
+  REQUIRE(manager.editTask("2 Walk the DOG").first.has_value());
+
+  for (bool enabled : {true, false}) {
+    manager.setFoldCache(enabled);
+    CoutCapture capture;
+    manager.ls("-f Milk");
+    manager.ls("-f dog");
+    const std::string out = capture.str();
+    REQUIRE(out.find("Buy MILK") != std::string::npos);
+    REQUIRE(out.find("Walk the DOG") != std::string::npos);
+  }
+
+  REQUIRE(manager.setOption("fold-cache on") == CustomError::Ok);
+  REQUIRE(manager.foldCache());
+  REQUIRE(manager.setOption("fold-cache maybe") == CustomError::ParseError);
+  REQUIRE(manager.setOption("nope on") == CustomError::ParseError);
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager ls intersects filters and counts", "[TaskManager]") {
+  const std::string path = makeTempPath("bitmap");
+  removeFile(path);
+
+  TaskManager manager(path);
+  manager.add("work:high:Ship release");
+  manager.add("work:high:Write notes");
+  manager.add("home:low:Water plants");
+  REQUIRE(manager.markDone("1") == CustomError::Ok);
+
+  {
+    CoutCapture capture;
+    manager.ls("-p -h");
+    const std::string out = capture.str();
+    REQUIRE(out.find("Write notes") != std::string::npos);
+    REQUIRE(out.find("Ship release") == std::string::npos);
+    REQUIRE(out.find("Water plants") == std::string::npos);
+  }
+  {
+    CoutCapture capture;
+    manager.ls("-h --count");
+    REQUIRE(capture.str() == "2\n");
+  }
+  REQUIRE(manager.remove("1") == CustomError::Ok);
+  {
+    CoutCapture capture;
+    manager.ls("-d --count");
+    REQUIRE(capture.str() == "0\n");
+  }
+  {
+    CoutCapture capture;
+    manager.ls("--count -f water");
+    REQUIRE(capture.str() == "1\n");
+  }
+  {
+    CoutCapture capture;
+    manager.ls("--nope");
+    REQUIRE(capture.str() == "Error: Parse Error\n");
+  }
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager filters by interned category", "[TaskManager]") {
+  const std::string path = makeTempPath("category");
+  removeFile(path);
+
+  {
+    TaskManager manager(path);
+    manager.add("work:high:Ship release");
+    manager.add("home:low:Water plants");
+    manager.add("work:low:Book flights");
+    REQUIRE(manager.save(path) == CustomError::Ok);
+  }
+
+  TaskManager manager(path);
+  {
+    CoutCapture capture;
+    manager.ls("-c work --count");
+    REQUIRE(capture.str() == "2\n");
+  }
+  {
+    CoutCapture capture;
+    manager.ls("-c work -l");
+    const std::string out = capture.str();
+    REQUIRE(out.find("Book flights") != std::string::npos);
+    REQUIRE(out.find("Ship release") == std::string::npos);
+  }
+  {
+    CoutCapture capture;
+    manager.ls("--category nowhere --count");
+    REQUIRE(capture.str() == "0\n");
+  }
+  REQUIRE(loadJson(path)["tasks"][1]["category"].get<std::string>() == "home");
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager tasks survive releasing loaded text storage",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("arena");
+  removeFile(path);
+
+  {
+    TaskManager manager(path);
+    manager.add("work:high:A task text long enough to skip small strings");
+    manager.add("home:low:Second loaded task with plenty of characters");
+    REQUIRE(manager.save(path) == CustomError::Ok);
+  }
+
+  TaskManager manager(path);
+  REQUIRE(manager.editTask("1 Edited text that also lives outside SSO")
+              .first.has_value());
+  auto removed = manager.removeTask("2");
+  REQUIRE(removed.first.has_value());
+
+  auto previous = manager.clearTasks();
+  manager.add("Fresh task after the arena was released");
+  REQUIRE(previous.size() == 1);
+  REQUIRE(previous[0].getText() == "Edited text that also lives outside SSO");
+  REQUIRE(removed.first->getText() ==
+          "Second loaded task with plenty of characters");
+
+  manager.loadTasks(previous);
+  REQUIRE(manager.insertByIndex(*removed.first, 1).has_value());
+  REQUIRE(manager.save(path) == CustomError::Ok);
+  json data = loadJson(path);
+  REQUIRE(data["tasks"].size() == 2);
+  REQUIRE(data["tasks"][1]["text"].get<std::string>() ==
+          "Second loaded task with plenty of characters");
+
+  removeFile(path);
+}
+
+namespace {
+// Task texts in the order they appear in captured ls output.
+std::vector<std::string> listedTexts(const std::string &out,
+                                     const std::vector<std::string> &texts) {
+  std::vector<std::pair<size_t, std::string>> found;
+  for (const auto &text : texts) {
+    size_t pos = out.find(text);
+    if (pos != std::string::npos) {
+      found.emplace_back(pos, text);
+    }
+  }
+  std::sort(found.begin(), found.end());
+  std::vector<std::string> ordered;
+  for (const auto &entry : found) {
+    ordered.push_back(entry.second);
+  }
+  return ordered;
+}
+} // namespace
+
+TEST_CASE("TaskManager sorted views follow mutations and stay stable",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("views");
+  removeFile(path);
+
+  TaskManager manager(path);
+  const std::vector<std::string> texts = {"T-one", "T-two", "T-three",
+                                          "T-four", "T-five"};
+  manager.add("a:high:T-one");
+  manager.add("a:low:T-two");
+  manager.add("a:high:T-three");
+  manager.add("a:low:T-four");
+  manager.add("a:medium:T-five");
+  REQUIRE(manager.markDone("3") == CustomError::Ok);
+  REQUIRE(manager.markDone("4") == CustomError::Ok);
+
+  {
+    CoutCapture capture;
+    manager.ls("-s priority");
+    REQUIRE(listedTexts(capture.str(), texts) ==
+            std::vector<std::string>{"T-two", "T-four", "T-five", "T-one",
+                                     "T-three"});
+  }
+  {
+    CoutCapture capture;
+    manager.ls("-s done");
+    REQUIRE(listedTexts(capture.str(), texts) ==
+            std::vector<std::string>{"T-three", "T-four", "T-one", "T-two",
+                                     "T-five"});
+  }
+
+  auto removed = manager.removeTask("2");
+  REQUIRE(removed.first.has_value());
+  REQUIRE(manager.undone("2") == CustomError::Ok);
+  {
+    CoutCapture capture;
+    manager.ls("-p -s priority");
+    REQUIRE(listedTexts(capture.str(), texts) ==
+            std::vector<std::string>{"T-five", "T-one", "T-three"});
+  }
+  REQUIRE(manager.insertByIndex(*removed.first, *removed.second).has_value());
+  {
+    CoutCapture capture;
+    manager.ls("-s priority");
+    REQUIRE(listedTexts(capture.str(), texts) ==
+            std::vector<std::string>{"T-two", "T-four", "T-five", "T-one",
+                                     "T-three"});
+  }
+  REQUIRE(manager.markDone("5") == CustomError::Ok);
+  REQUIRE(manager.getTaskDoneStatus("5").value());
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager ls limit and offset page through every ordering",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("limit");
+  removeFile(path);
+
+  TaskManager manager(path);
+  std::vector<std::string> texts;
+  const char *priorities[] = {"low", "medium", "high"};
+  for (int i = 0; i < 40; ++i) {
+    texts.push_back("Item-" + std::to_string(100 + i));
+    manager.add(std::string(i % 2 ? "odd" : "even") + ":" +
+                priorities[(i * 7) % 3] + ":" + texts.back());
+    if (i % 3 == 0) {
+      REQUIRE(manager.markDone(std::to_string(i + 1)) == CustomError::Ok);
+    }
+  }
+
+  for (const std::string options :
+       {"", "-s priority", "-s done", "-s id", "-p -s priority",
+        "-c odd -s done", "-f item-1 -s priority", "-h"}) {
+    std::string full;
+    {
+      CoutCapture capture;
+      manager.ls(options);
+      full = capture.str();
+    }
+    const std::vector<std::string> all = listedTexts(full, texts);
+    for (size_t offset : {0, 3, 38}) {
+      CoutCapture capture;
+      manager.ls(options + " --offset " + std::to_string(offset) +
+                 " --limit 5");
+      std::vector<std::string> expected;
+      for (size_t i = offset; i < all.size() && i < offset + 5; ++i) {
+        expected.push_back(all[i]);
+      }
+      REQUIRE(listedTexts(capture.str(), texts) == expected);
+    }
+    // offset + limit past SIZE_MAX still means "everything after offset".
+    CoutCapture capture;
+    manager.ls(options + " --offset 1 --limit 18446744073709551615");
+    const std::vector<std::string> rest(all.begin() + (all.empty() ? 0 : 1),
+                                        all.end());
+    REQUIRE(listedTexts(capture.str(), texts) == rest);
+  }
+  {
+    CoutCapture capture;
+    manager.ls("--fuzzy item-l00 --offset 1 --limit 18446744073709551615");
+    REQUIRE(!listedTexts(capture.str(), texts).empty());
+  }
+  {
+    CoutCapture capture;
+    manager.ls("--count --limit 1");
+    REQUIRE(capture.str() == "40\n");
+  }
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager ls color modes", "[TaskManager]") {
+  const std::string path = makeTempPath("color");
+  removeFile(path);
+
+  TaskManager manager(path);
+  manager.add("work:high:Ship release");
+  REQUIRE(manager.markDone("1") == CustomError::Ok);
+
+  REQUIRE(manager.setOption("color on") == CustomError::Ok);
+  {
+    CoutCapture capture;
+    manager.ls("");
+    REQUIRE(capture.str() ==
+            "1 [id=1] [work] [\033[31mhigh\033[0m]  🗹 Ship release\n");
+  }
+  {
+    CoutCapture capture;
+    manager.ls("--plain");
+    REQUIRE(capture.str() == "1 [id=1] [work] [high]  🗹 Ship release\n");
+  }
+  REQUIRE(manager.setOption("color off") == CustomError::Ok);
+  {
+    CoutCapture capture;
+    manager.ls("");
+    REQUIRE(capture.str().find('\033') == std::string::npos);
+  }
+  REQUIRE(manager.setOption("color auto") == CustomError::Ok);
+  REQUIRE(manager.setOption("color sometimes") == CustomError::ParseError);
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager ls streams JSON Lines", "[TaskManager]") {
+  const std::string path = makeTempPath("jsonl");
+  removeFile(path);
+
+  TaskManager manager(path);
+  manager.add("work:high:Quote \"this\" \\ path");
+  manager.add("home:low:Water plants");
+  REQUIRE(manager.markDone("2") == CustomError::Ok);
+
+  CoutCapture capture;
+  manager.ls("--format=jsonl -s priority");
+  std::istringstream lines(capture.str());
+  std::string line;
+  std::vector<json> rows;
+  while (std::getline(lines, line)) {
+    rows.push_back(json::parse(line));
+  }
+  REQUIRE(rows.size() == 2);
+  REQUIRE(rows[0]["id"].get<uint64_t>() == 2);
+  REQUIRE(rows[0]["text"].get<std::string>() == "Water plants");
+  REQUIRE(rows[0]["done"].get<bool>());
+  REQUIRE(rows[0]["priority"].get<int>() == static_cast<int>(Priority::low));
+  REQUIRE(rows[1]["text"].get<std::string>() == "Quote \"this\" \\ path");
+  REQUIRE(rows[1]["category"].get<std::string>() == "work");
+  REQUIRE(!rows[1]["done"].get<bool>());
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager ls on an empty list", "[TaskManager]") {
+  const std::string path = makeTempPath("empty");
+  removeFile(path);
+
+  TaskManager manager(path);
+  auto output = [&manager](const std::string &flag) {
+    CoutCapture capture;
+    manager.ls(flag);
+    return capture.str();
+  };
+  REQUIRE(output("") == "Todo List is empty!\n");
+  REQUIRE(output("--format=jsonl").empty());
+  REQUIRE(output("--format=jsonl -f a --pager").empty());
+  REQUIRE(output("--bogus") != "Todo List is empty!\n");
+  // Counts are numbers even when there is nothing to count.
+  REQUIRE(output("--count") == "0\n");
+  REQUIRE(output("--count -d") == "0\n");
+  REQUIRE(output("--count -f a") == "0\n");
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager ls pager renders one page per answer",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("pager");
+  removeFile(path);
+
+  TaskManager manager(path);
+  for (int i = 1; i <= 5; ++i) {
+    manager.add("Row-" + std::to_string(i));
+  }
+  REQUIRE(manager.setOption("page-size 2") == CustomError::Ok);
+  REQUIRE(manager.setOption("page-size 0") == CustomError::ParseError);
+
+  std::istringstream answers("\n\n");
+  std::streambuf *oldIn = std::cin.rdbuf(answers.rdbuf());
+  std::string out;
+  {
+    CoutCapture capture;
+    manager.ls("--pager --plain");
+    out = capture.str();
+  }
+  std::cin.rdbuf(oldIn);
+
+  REQUIRE(out == "1 [id=1] [general] [low]  ☐ Row-1\n"
+                 "2 [id=2] [general] [low]  ☐ Row-2\n"
+                 "-- Enter for more, q to stop --\n"
+                 "3 [id=3] [general] [low]  ☐ Row-3\n"
+                 "4 [id=4] [general] [low]  ☐ Row-4\n"
+                 "-- 4 of 5, Enter for more, q to stop --\n"
+                 "5 [id=5] [general] [low]  ☐ Row-5\n");
+
+  std::istringstream quit("q\n");
+  oldIn = std::cin.rdbuf(quit.rdbuf());
+  {
+    CoutCapture capture;
+    manager.ls("--pager --plain -s priority");
+    REQUIRE(capture.str().find("Row-3") == std::string::npos);
+    REQUIRE(capture.str().find("Row-2") != std::string::npos);
+  }
+  std::cin.rdbuf(oldIn);
+
+  // Exactly one page: no prompt.
+  {
+    CoutCapture capture;
+    manager.ls("--pager --plain --limit 2");
+    REQUIRE(capture.str().find("Enter for more") == std::string::npos);
+    REQUIRE(capture.str().find("Row-2") != std::string::npos);
+  }
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager caches ls results until the next mutation",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("qcache");
+  removeFile(path);
+
+  TaskManager manager(path);
+  manager.add("work:high:Alpha");
+  manager.add("home:low:Beta");
+  const uint64_t before = manager.version();
+
+  auto listing = [&manager](const std::string &flag) {
+    CoutCapture capture;
+    manager.ls(flag);
+    return capture.str();
+  };
+  const std::string first = listing("-p -s priority --plain");
+  REQUIRE(manager.queryCacheHits() == 0);
+  REQUIRE(listing("--plain -s priority -p") == first);
+  REQUIRE(manager.queryCacheHits() == 1);
+  REQUIRE(manager.version() == before);
+
+  REQUIRE(manager.markDone("2") == CustomError::Ok);
+  REQUIRE(manager.version() > before);
+  const std::string after = listing("-p -s priority --plain");
+  REQUIRE(manager.queryCacheHits() == 1);
+  REQUIRE(after.find("Beta") == std::string::npos);
+  REQUIRE(after.find("Alpha") != std::string::npos);
+
+  REQUIRE(manager.setOption("query-cache 0") == CustomError::Ok);
+  listing("-p -s priority --plain");
+  listing("-p -s priority --plain");
+  REQUIRE(manager.queryCacheHits() == 1);
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager saved views follow every change", "[TaskManager]") {
+  const std::string path = makeTempPath("views");
+  removeFile(path);
+  const std::vector<std::string> texts = {"Alpha", "Beta", "Gamma", "Delta"};
+
+  {
+    TaskManager manager(path);
+    manager.add("work:high:Alpha");
+    manager.add("home:high:Beta");
+    manager.add("work:low:Gamma");
+
+    REQUIRE(manager.saveView("urgent -p -h -c work --plain") ==
+            CustomError::Ok);
+    REQUIRE(manager.saveView("list -p") == CustomError::ParseError);
+    REQUIRE(manager.saveView("bad --nope") == CustomError::ParseError);
+    REQUIRE(manager.openView("missing") == CustomError::NoSuchView);
+
+    auto opened = [&]() {
+      CoutCapture capture;
+      REQUIRE(manager.openView("urgent") == CustomError::Ok);
+      return listedTexts(capture.str(), texts);
+    };
+    REQUIRE(opened() == std::vector<std::string>{"Alpha"});
+
+    manager.add("work:high:Delta");
+    REQUIRE(opened() == std::vector<std::string>{"Alpha", "Delta"});
+
+    REQUIRE(manager.markDone("1") == CustomError::Ok);
+    REQUIRE(opened() == std::vector<std::string>{"Delta"});
+    REQUIRE(manager.undone("1") == CustomError::Ok);
+    REQUIRE(opened() == std::vector<std::string>{"Alpha", "Delta"});
+
+    auto [task, index] = manager.removeTask("1");
+    REQUIRE(task);
+    REQUIRE(opened() == std::vector<std::string>{"Delta"});
+    manager.insertByIndex(*task, *index);
+    REQUIRE(opened() == std::vector<std::string>{"Alpha", "Delta"});
+
+    REQUIRE(manager.saveView("found -f gam") == CustomError::Ok);
+    {
+      CoutCapture capture;
+      manager.openView("found");
+      REQUIRE(listedTexts(capture.str(), texts) ==
+              std::vector<std::string>{"Gamma"});
+    }
+    manager.editTask("3 Beta two");
+    {
+      CoutCapture capture;
+      manager.openView("found");
+      REQUIRE(capture.str().empty());
+    }
+    REQUIRE(manager.save(path) == CustomError::Ok);
+  }
+
+  REQUIRE(loadJson(path)["views"]["urgent"] == "-p -h -c work --plain");
+  TaskManager reloaded(path);
+  {
+    CoutCapture capture;
+    REQUIRE(reloaded.openView("urgent") == CustomError::Ok);
+    REQUIRE(listedTexts(capture.str(), texts) ==
+            std::vector<std::string>{"Alpha", "Delta"});
+  }
+  REQUIRE(reloaded.deleteView("urgent") == CustomError::Ok);
+  REQUIRE(reloaded.openView("urgent") == CustomError::NoSuchView);
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager ls --fuzzy ranks matches by edit distance",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("fuzzy");
+  removeFile(path);
+  const std::vector<std::string> texts = {"Team meetxxg", "Team metting",
+                                          "Team meeting", "Buy milk",
+                                          "Meeting notes"};
+
+  TaskManager manager(path);
+  manager.add("work:low:Team meetxxg");
+  manager.add("work:high:Team metting");
+  manager.add("work:low:Buy milk");
+  manager.add("work:low:Team meeting");
+  manager.add("home:high:Meeting notes");
+
+  auto listing = [&](const std::string &flag) {
+    CoutCapture capture;
+    manager.ls(flag);
+    return listedTexts(capture.str(), texts);
+  };
+  // "Team meetxxg" is two edits away, more than a 7-letter pattern allows.
+  REQUIRE(listing("--fuzzy meeting --plain") ==
+          std::vector<std::string>{"Team meeting", "Meeting notes",
+                                   "Team metting"});
+  REQUIRE(listing("--fuzzy meeting --limit 1 --plain") ==
+          std::vector<std::string>{"Team meeting"});
+  REQUIRE(listing("--fuzzy meeting --limit 1 --offset 2 --plain") ==
+          std::vector<std::string>{"Team metting"});
+  REQUIRE(listing("--fuzzy meeting -s priority --plain") ==
+          std::vector<std::string>{"Team meeting", "Team metting",
+                                   "Meeting notes"});
+  REQUIRE(listing("--fuzzy meeting -c work --plain") ==
+          std::vector<std::string>{"Team meeting", "Team metting"});
+  {
+    CoutCapture capture;
+    manager.ls("--fuzzy meeting --count");
+    REQUIRE(capture.str() == "3\n");
+  }
+
+  REQUIRE(manager.saveView("typo --fuzzy meeting --plain") == CustomError::Ok);
+  {
+    CoutCapture capture;
+    manager.openView("typo");
+    REQUIRE(listedTexts(capture.str(), texts) ==
+            std::vector<std::string>{"Team meeting", "Meeting notes",
+                                     "Team metting"});
+  }
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager ls --regex filters with the other options",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("regex");
+  removeFile(path);
+  const std::vector<std::string> texts = {"Pay gas bill", "Pay rent",
+                                          "pay water bill", "File taxes"};
+
+  TaskManager manager(path);
+  manager.add("home:low:Pay gas bill");
+  manager.add("home:high:Pay rent");
+  manager.add("work:high:pay water bill");
+  manager.add("work:low:File taxes");
+
+  auto listing = [&](const std::string &flag) {
+    CoutCapture capture;
+    manager.ls(flag);
+    return listedTexts(capture.str(), texts);
+  };
+  REQUIRE(listing("--regex ^pay .* bill$ --plain") ==
+          std::vector<std::string>{"Pay gas bill", "pay water bill"});
+  REQUIRE(listing("--regex ^pay .* bill$ -h --plain") ==
+          std::vector<std::string>{"pay water bill"});
+  REQUIRE(listing("--regex (rent|taxes) -s priority --plain") ==
+          std::vector<std::string>{"File taxes", "Pay rent"});
+  REQUIRE(listing("--regex bill -f gas --plain") ==
+          std::vector<std::string>{"Pay gas bill"});
+  {
+    CoutCapture capture;
+    manager.ls("--regex bill$ --count");
+    REQUIRE(capture.str() == "2\n");
+  }
+  {
+    CoutCapture capture;
+    manager.ls("--regex (bill");
+    REQUIRE(capture.str() == "Error: Parse Error\n");
+  }
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager parallel filtering matches the serial result",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("parallel");
+  removeFile(path);
+
+  TaskManager manager(path);
+  const char *words[] = {"alpha", "beta", "gamma", "delta", "omega"};
+  for (size_t i = 0; i < 500; ++i) {
+    manager.add(std::string(i % 3 ? "work" : "home") + ":" +
+                (i % 2 ? "high" : "low") + ":" + words[i % 5] + " " +
+                std::to_string(i));
+  }
+  REQUIRE(manager.setOption("query-cache 0") == CustomError::Ok);
+  REQUIRE(manager.setOption("threads x") == CustomError::ParseError);
+  REQUIRE(manager.setOption("parallel-threshold -1") ==
+          CustomError::ParseError);
+
+  auto listing = [&manager](const std::string &flag) {
+    CoutCapture capture;
+    manager.ls(flag);
+    return capture.str();
+  };
+  const std::vector<std::string> flags = {
+      "-f ta --plain", "-c work -f a 1 --plain", "--regex ^(al|om).*[05]$",
+      "--fuzzy gamna --plain", "--fuzzy omeg -s priority --count"};
+  std::vector<std::string> serial;
+  for (const auto &flag : flags) {
+    serial.push_back(listing(flag));
+  }
+  REQUIRE(manager.setOption("threads 4") == CustomError::Ok);
+  REQUIRE(manager.setOption("parallel-threshold 0") == CustomError::Ok);
+  for (size_t i = 0; i < flags.size(); ++i) {
+    REQUIRE(listing(flags[i]) == serial[i]);
+  }
+  // Far more threads than rows or cores is capped, not an abort.
+  REQUIRE(manager.setOption("threads 200000") == CustomError::Ok);
+  for (size_t i = 0; i < flags.size(); ++i) {
+    REQUIRE(listing(flags[i]) == serial[i]);
+  }
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager groups ls by category and keeps stats current",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("group");
+  removeFile(path);
+
+  TaskManager manager(path);
+  manager.add("work:high:Ship release");
+  manager.add("home:low:Water plants");
+  manager.add("work:low:Answer mail");
+  manager.add("home:high:Fix sink");
+
+  auto output = [&manager](const std::string &flag) {
+    CoutCapture capture;
+    manager.ls(flag);
+    return capture.str();
+  };
+  const std::string grouped = output("--group category --plain");
+  REQUIRE(grouped.find("== home (2) ==") < grouped.find("Water plants"));
+  REQUIRE(grouped.find("Water plants") < grouped.find("Fix sink"));
+  REQUIRE(grouped.find("Fix sink") < grouped.find("== work (2) =="));
+  REQUIRE(grouped.find("== work (2) ==") < grouped.find("Ship release"));
+  REQUIRE(grouped.find("Ship release") < grouped.find("Answer mail"));
+  REQUIRE(output("--group category --format jsonl").find("==") ==
+          std::string::npos);
+
+  REQUIRE(output("--group category --count") == "home: 2\nwork: 2\n");
+  REQUIRE(output("--group category --count -h") == "home: 1\nwork: 1\n");
+  REQUIRE(output("--group category --count -f ip") == "work: 1\n");
+
+  REQUIRE(manager.markDone("1") == CustomError::Ok);
+  REQUIRE(output("--group category --count -p") == "home: 2\nwork: 1\n");
+  manager.removeTask("2");
+  REQUIRE(output("--group category --count") == "home: 1\nwork: 2\n");
+
+  CoutCapture capture;
+  manager.stats();
+  std::istringstream lines(capture.str());
+  std::vector<std::string> rows;
+  for (std::string line; std::getline(lines, line);) {
+    std::istringstream words(line);
+    std::string row;
+    for (std::string word; words >> word;) {
+      row += (row.empty() ? "" : " ") + word;
+    }
+    rows.push_back(row);
+  }
+  REQUIRE(rows == std::vector<std::string>{
+                      "category total done pending high medium low",
+                      "home 1 0 1 1 0 0", "work 2 1 1 0 0 1",
+                      "all 3 1 2 1 0 1"});
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager ls --explain reports the plan it ran",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("explain");
+  removeFile(path);
+
+  TaskManager manager(path);
+  manager.add("work:high:Alpha");
+  manager.add("home:low:Beta");
+  manager.add("work:low:Gamma");
+
+  // The listing goes to stdout and the plan to stderr; tests read both.
+  auto explain = [&manager](const std::string &flag) {
+    CoutCapture capture;
+    StreamCapture plan(std::cerr);
+    manager.ls("--explain " + flag);
+    REQUIRE(capture.str().find("-- plan --") == std::string::npos);
+    REQUIRE(plan.str().find("-- plan --") == 0);
+    return capture.str() + plan.str();
+  };
+
+  std::string out = explain("-p -c work -f a -s id --plain");
+  REQUIRE(out.find("Alpha") < out.find("-- plan --"));
+  REQUIRE(out.find("AND/OR of done and priority bitmaps") !=
+          std::string::npos);
+  REQUIRE(out.find("full scan; category, --find") != std::string::npos);
+  REQUIRE(out.find("radix sort on id") != std::string::npos);
+  REQUIRE(out.find("render") != std::string::npos);
+
+  out = explain("-s done --limit 1 --plain");
+  REQUIRE(out.find("done bitmaps walked key by key") != std::string::npos);
+  REQUIRE(out.find("offset 0, limit 1") != std::string::npos);
+  REQUIRE(out.find("sort ") == std::string::npos);
+
+  out = explain("-p -c work -f a -s id --plain");
+  REQUIRE(out.find("hit, result reused") != std::string::npos);
+
+  out = explain("--count -l");
+  REQUIRE(out.find("2\n") == 0);
+  REQUIRE(out.find("popcount") != std::string::npos);
+
+  out = explain("--fuzzy gamna --limit 1 --plain");
+  REQUIRE(out.find("top-1 heap") != std::string::npos);
+
+  {
+    CoutCapture capture;
+    StreamCapture plan(std::cerr);
+    manager.ls("--explain --format=jsonl -s id");
+    std::istringstream lines(capture.str());
+    std::string line;
+    size_t rows = 0;
+    while (std::getline(lines, line)) {
+      REQUIRE(json::parse(line).is_object());
+      ++rows;
+    }
+    REQUIRE(rows == 3);
+    REQUIRE(plan.str().find("-- plan --") == 0);
+  }
+
+  CoutCapture capture;
+  manager.ls("-p --plain");
+  REQUIRE(capture.str().find("-- plan --") == std::string::npos);
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager prefix lookup follows edits and resolves numbers",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("prefix");
+  removeFile(path);
+  const std::vector<std::string> texts = {"Buy milk", "Build shed",
+                                          "Call mum", "Buy bread"};
+
+  TaskManager manager(path);
+  manager.add("home:low:Buy milk");
+  manager.add("home:low:Build shed");
+  manager.add("home:low:Call mum");
+
+  auto found = [&](const std::string &prefix) {
+    CoutCapture capture;
+    manager.findPrefix(prefix);
+    return listedTexts(capture.str(), texts);
+  };
+  REQUIRE(found("BU") == std::vector<std::string>{"Buy milk", "Build shed"});
+  REQUIRE(found("bu m") == std::vector<std::string>{"Buy milk"});
+
+  manager.add("home:low:Buy bread");
+  manager.editTask("2 Paint shed");
+  REQUIRE(found("bu") == std::vector<std::string>{"Buy milk", "Buy bread"});
+  REQUIRE(found("sh") == std::vector<std::string>{});
+
+  REQUIRE(manager.completeTaskNumber("b") == std::vector<size_t>{1, 4});
+  REQUIRE(manager.completeTaskNumber("bu") == std::vector<size_t>{1, 4});
+  REQUIRE(manager.completeTaskNumber("bre") == std::vector<size_t>{4});
+  REQUIRE(manager.completeTaskNumber("buy m") == std::vector<size_t>{1});
+  REQUIRE(manager.completeTaskNumber("x").empty());
+
+  REQUIRE(manager.markDone("buy br") == CustomError::Ok);
+  REQUIRE(manager.getTaskDoneStatus("4") == true);
+  {
+    CoutCapture capture;
+    REQUIRE(manager.markDone("buy") == CustomError::AmbiguousTask);
+    REQUIRE(capture.str().empty());
+  }
+  REQUIRE(manager.markDone("zzz") == CustomError::NoSuchTask);
+  REQUIRE(manager.markDone("9x") == CustomError::InvalidNumber);
+
+  // Destructive commands take numbers only.
+  REQUIRE(manager.remove("call") == CustomError::InvalidNumber);
+  REQUIRE(manager.editTask("call Call dad").first == std::nullopt);
+  REQUIRE(manager.remove("3") == CustomError::Ok);
+  REQUIRE(manager.completeTaskNumber("c").empty());
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager sorts ls by text and by category name",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("sort_text");
+  removeFile(path);
+  const std::vector<std::string> texts = {
+      "pay invoice march", "Pay invoice april", "buy milk", "Pay", "zoo", "apple"};
+
+  TaskManager manager(path);
+  manager.add("work:low:pay invoice march");
+  manager.add("home:low:Pay invoice april");
+  manager.add("zeta:low:buy milk");
+  manager.add("alpha:low:Pay");
+  manager.add("home:low:zoo");
+
+  auto listed = [&](const std::string &flags) {
+    CoutCapture capture;
+    manager.ls(flags);
+    return listedTexts(capture.str(), texts);
+  };
+  REQUIRE(listed("-s text") ==
+          std::vector<std::string>{"buy milk", "Pay", "Pay invoice april",
+                                   "pay invoice march", "zoo"});
+  REQUIRE(listed("-s category") ==
+          std::vector<std::string>{"Pay", "Pay invoice april", "zoo",
+                                   "pay invoice march", "buy milk"});
+
+  manager.editTask("5 apple");
+  REQUIRE(listed("-s text --limit 2") ==
+          std::vector<std::string>{"apple", "buy milk"});
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager sorts categories case-insensitively", "[TaskManager]") {
+  const std::string path = makeTempPath("sort_category_case");
+  removeFile(path);
+  const std::vector<std::string> texts = {"in Work", "in alpha", "in Beta"};
+
+  TaskManager manager(path);
+  manager.add("Work:low:in Work");
+  manager.add("alpha:low:in alpha");
+  manager.add("Beta:low:in Beta");
+
+  CoutCapture capture;
+  manager.ls("-s category");
+  REQUIRE(listedTexts(capture.str(), texts) ==
+          std::vector<std::string>{"in alpha", "in Beta", "in Work"});
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager bounded sorted ls keeps file order for ties",
+          "[TaskManager]") {
+  const std::string path = makeTempPath("file_order");
+  removeFile(path);
+  {
+    json root;
+    root["next_id"] = 8;
+    root["tasks"] = json::array();
+    for (auto [id, text, done] : {std::tuple{5, "task five", false},
+                                  std::tuple{2, "task two", true},
+                                  std::tuple{7, "task seven", false}}) {
+      root["tasks"].push_back({{"id", id},
+                               {"text", text},
+                               {"category", "general"},
+                               {"priority", 0},
+                               {"done", done}});
+    }
+    std::ofstream(path) << root.dump();
+  }
+  const std::vector<std::string> texts = {"task five", "task two",
+                                          "task seven"};
+
+  TaskManager manager(path);
+  auto listed = [&](const std::string &flags) {
+    CoutCapture capture;
+    manager.ls(flags);
+    return listedTexts(capture.str(), texts);
+  };
+  REQUIRE(listed("-s priority") == texts);
+  REQUIRE(listed("-s priority --limit 3") == texts);
+  REQUIRE(listed("-s priority --offset 1 --limit 1") ==
+          std::vector<std::string>{"task two"});
+  REQUIRE(listed("-s done") ==
+          std::vector<std::string>{"task two", "task five", "task seven"});
+  REQUIRE(listed("-s done --limit 2") ==
+          std::vector<std::string>{"task two", "task five"});
+
+  removeFile(path);
+}
+
+TEST_CASE("TaskManager pager pages match the full listing", "[TaskManager]") {
+  const std::string path = makeTempPath("pager_order");
+  removeFile(path);
+  {
+    json root;
+    root["next_id"] = 8;
+    root["tasks"] = json::array();
+    for (int id : {5, 2, 7}) {
+      root["tasks"].push_back({{"id", id},
+                               {"text", "task " + std::to_string(id)},
+                               {"category", "general"},
+                               {"priority", 0},
+                               {"done", id == 2}});
+    }
+    std::ofstream(path) << root.dump();
+  }
+  const std::vector<std::string> texts = {"task 5", "task 2", "task 7"};
+
+  TaskManager manager(path);
+  REQUIRE(manager.setOption("page-size 1") == CustomError::Ok);
+  for (const std::string options : {"", "-s priority", "-s done", "-s id",
+                                    "-s text", "-f task"}) {
+    std::string full;
+    {
+      CoutCapture capture;
+      manager.ls(options + " --plain");
+      full = capture.str();
+    }
+    std::istringstream answers("\n\n\n\n");
+    std::streambuf *oldIn = std::cin.rdbuf(answers.rdbuf());
+    std::string paged;
+    {
+      CoutCapture capture;
+      manager.ls(options + " --plain --pager");
+      paged = capture.str();
+    }
+    std::cin.rdbuf(oldIn);
+    REQUIRE(listedTexts(paged, texts) == listedTexts(full, texts));
+    REQUIRE(paged.find("3 of 3") == std::string::npos);
+  }
+
+  removeFile(path);
+}
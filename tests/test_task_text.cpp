@@ -0,0 +1,38 @@
+#include "../include/TaskText.hpp"
+#include "../include/catch.hpp"
+#include <memory_resource>
+#include <string>
+
+TEST_CASE("TaskText stores short text inline", "[TaskText]") {
+  std::pmr::monotonic_buffer_resource arena;
+  const std::string shortText(TaskText::kInlineCapacity, 'x');
+  TaskText text(shortText, &arena);
+
+  REQUIRE(text.view() == shortText);
+  REQUIRE(text.size() == TaskText::kInlineCapacity);
+  TaskText empty;
+  REQUIRE(empty.view().empty());
+}
+
+TEST_CASE("TaskText copies to the heap and moves keep the block",
+          "[TaskText]") {
+  std::pmr::monotonic_buffer_resource arena;
+  const std::string longText(TaskText::kInlineCapacity + 10, 'y');
+  TaskText original(longText, &arena);
+  const char *block = original.view().data();
+
+  TaskText copy(original);
+  REQUIRE(copy.view() == longText);
+  REQUIRE(copy.view().data() != block);
+
+  TaskText moved(std::move(original));
+  REQUIRE(moved.view().data() == block);
+  REQUIRE(original.view().empty());
+
+  TaskText target("short");
+  target = std::move(moved);
+  REQUIRE(target.view().data() == block);
+  target = copy;
+  REQUIRE(target.view() == longText);
+  REQUIRE(target.view().data() != copy.view().data());
+}
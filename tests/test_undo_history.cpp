@@ -0,0 +1,104 @@
+#include "../include/UndoHistory.hpp"
+#include "../include/Utils.hpp"
+#include "../include/catch.hpp"
+#include <memory>
+#include <vector>
+
+namespace {
+// Records its tag when undone and reports a fixed footprint.
+class TagCommand : public Command {
+private:
+  std::vector<int> &undone_;
+  int tag_;
+  size_t bytes_;
+
+public:
+  TagCommand(std::vector<int> &undone, int tag, size_t bytes)
+      : undone_(undone), tag_(tag), bytes_(bytes) {}
+  CustomError execute() override { return CustomError::Ok; }
+  CustomError undo() override {
+    undone_.push_back(tag_);
+    return CustomError::Ok;
+  }
+  CustomError redo() override { return CustomError::Ok; }
+  size_t footprint() const override { return bytes_; }
+};
+} // namespace
+
+TEST_CASE("UndoHistory drops the oldest entries past its depth",
+          "[UndoHistory]") {
+  std::vector<int> undone;
+  UndoHistory history(3, 1000);
+  for (int tag = 1; tag <= 5; ++tag) {
+    REQUIRE(history.push(std::make_unique<TagCommand>(undone, tag, 10)));
+  }
+  REQUIRE(history.size() == 3);
+  REQUIRE(history.bytes() == 30);
+  REQUIRE(history.evicted() == 2);
+
+  while (auto command = history.pop()) {
+    visitCommand(*command, [](auto &held) { return held.undo(); });
+  }
+  REQUIRE(undone == std::vector<int>{5, 4, 3});
+  REQUIRE(history.bytes() == 0);
+  REQUIRE(!history.pop().has_value());
+}
+
+TEST_CASE("UndoHistory keeps within its byte budget", "[UndoHistory]") {
+  std::vector<int> undone;
+  UndoHistory history(10, 100);
+  history.push(std::make_unique<TagCommand>(undone, 1, 40));
+  history.push(std::make_unique<TagCommand>(undone, 2, 40));
+  history.push(std::make_unique<TagCommand>(undone, 3, 40));
+  REQUIRE(history.size() == 2);
+  REQUIRE(history.bytes() == 80);
+  REQUIRE(history.evicted() == 1);
+
+  // Larger than the whole budget: not kept, and the rest stays.
+  REQUIRE(!history.push(std::make_unique<TagCommand>(undone, 4, 101)));
+  REQUIRE(history.size() == 2);
+  REQUIRE(history.evicted() == 2);
+
+  history.push(std::make_unique<TagCommand>(undone, 5, 10));
+  history.setLimits(2, 60);
+  REQUIRE(history.size() == 2);
+  REQUIRE(history.bytes() == 50);
+  REQUIRE(history.depth() == 2);
+  history.push(std::make_unique<TagCommand>(undone, 6, 10));
+  while (auto command = history.pop()) {
+    visitCommand(*command, [](auto &held) { return held.undo(); });
+  }
+  REQUIRE(undone == std::vector<int>{6, 5});
+
+  // Depth 0 is off, not full: nothing is counted as evicted.
+  const size_t evicted = history.evicted();
+  history.setLimits(0, 60);
+  REQUIRE(!history.push(std::make_unique<TagCommand>(undone, 7, 1)));
+  REQUIRE(history.evicted() == evicted);
+}
+
+TEST_CASE("UndoHistory grows its ring only as entries arrive",
+          "[UndoHistory]") {
+  std::vector<int> undone;
+  UndoHistory history(size_t{1} << 60, 1000);
+  for (int tag = 1; tag <= 40; ++tag) {
+    history.push(std::make_unique<TagCommand>(undone, tag, 1));
+  }
+  // Wrap the ring by evicting, then grow it again.
+  history.setLimits(size_t{1} << 60, 30);
+  for (int tag = 41; tag <= 50; ++tag) {
+    history.push(std::make_unique<TagCommand>(undone, tag, 1));
+  }
+  history.setLimits(size_t{1} << 60, 1000);
+  for (int tag = 51; tag <= 90; ++tag) {
+    history.push(std::make_unique<TagCommand>(undone, tag, 1));
+  }
+  REQUIRE(history.size() == 70);
+  while (auto command = history.pop()) {
+    visitCommand(*command, [](auto &held) { return held.undo(); });
+  }
+  REQUIRE(undone.size() == 70);
+  for (size_t i = 0; i < undone.size(); ++i) {
+    REQUIRE(undone[i] == 90 - static_cast<int>(i));
+  }
+}